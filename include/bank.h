@@ -0,0 +1,74 @@
+#ifndef BANK_H_5D0C8E27A4B19F63
+#define BANK_H_5D0C8E27A4B19F63
+
+#include "game.h"
+#include "sudoku.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Packed puzzle bank, all fields little-endian:
+//
+//   header   magic "CSBK", u16 version, u16 record size,
+//            u32 count[DIFFICULTY_COUNT], u32 offset[DIFFICULTY_COUNT],
+//            u32 CRC-32 of everything after the header
+//   records  fixed-size, grouped by difficulty, each starting at offset[d]
+//
+// A record is an 81-bit givens mask (bit i set: cell i is a given) followed
+// by the solution, three digits per 10-bit group (27 groups). The grid is
+// the solution with non-givens blanked, so a puzzle takes 45 bytes instead
+// of the 162 of sudoku_puzzle_t.
+#define BANK_MAGIC "CSBK"
+#define BANK_VERSION 1
+#define BANK_MASK_BYTES 11
+#define BANK_SOLUTION_BYTES 34
+#define BANK_RECORD_SIZE (BANK_MASK_BYTES + BANK_SOLUTION_BYTES)
+#define BANK_HEADER_SIZE (4 + 2 + 2 + DIFFICULTY_COUNT * 8 + 4)
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    uint32_t count[DIFFICULTY_COUNT];
+    uint32_t offset[DIFFICULTY_COUNT];
+    uint32_t crc;
+} bank_t;
+
+void bank_encode_puzzle(const sudoku_puzzle_t *puzzle,
+                        uint8_t record[BANK_RECORD_SIZE]);
+// Fails on records no encoder could have written: a group of 729 or more,
+// or bits set past the 81 cells of the mask or the 27 groups.
+bool bank_decode_puzzle(const uint8_t record[BANK_RECORD_SIZE],
+                        sudoku_puzzle_t *puzzle);
+
+// Attaches to a bank image already in memory (flash on the device) and
+// checks its header; records are decoded on demand by bank_get().
+bool bank_open(bank_t *bank, const uint8_t *data, size_t size);
+bool bank_verify(const bank_t *bank);
+
+uint32_t bank_count(const bank_t *bank, difficulty_t difficulty);
+// False for an index out of range or a record that does not decode.
+bool bank_get(const bank_t *bank, difficulty_t difficulty, uint32_t index,
+              sudoku_puzzle_t *puzzle);
+
+#ifdef NOPICO
+// Host only: memory-map a bank file, and build one from puzzles placed in
+// any order into slots fixed by bank_writer_open()'s per-difficulty counts.
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    uint32_t count[DIFFICULTY_COUNT];
+    uint32_t offset[DIFFICULTY_COUNT];
+} bank_writer_t;
+
+bool bank_map_file(bank_t *bank, const char *path);
+void bank_unmap(bank_t *bank);
+
+bool bank_writer_open(bank_writer_t *writer,
+                      const uint32_t count[DIFFICULTY_COUNT]);
+bool bank_writer_put(bank_writer_t *writer, difficulty_t difficulty,
+                     uint32_t index, const sudoku_puzzle_t *puzzle);
+bool bank_writer_save(bank_writer_t *writer, const char *path);
+void bank_writer_close(bank_writer_t *writer);
+#endif
+
+#endif // BANK_H_5D0C8E27A4B19F63
@@ -0,0 +1,39 @@
+#ifndef CODE_H_DC6400EE0413FD91
+#define CODE_H_DC6400EE0413FD91
+
+#include "game.h"
+#include "generator.h"
+#include "sudoku.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Puzzle codes: a generated puzzle is fully determined by its seed, its
+// difficulty and the generator version, so those three are all it takes to
+// share or replay one. A code packs them as
+//
+//   version (4 bits) | difficulty (2 bits) | seed (GENERATOR_SEED_BITS)
+//
+// written in decimal with a trailing Damm check digit, which catches every
+// single wrong digit and every swap of two neighbouring ones. Nine digits,
+// so it can be read off the OLED and typed on the keypad.
+#define PUZZLE_CODE_DIGITS 9
+
+uint32_t puzzle_code_make(uint32_t seed, difficulty_t difficulty);
+
+// Splits a code. Returns false if the check digit is wrong or the code is
+// from another generator version, whose puzzles this build cannot make.
+bool puzzle_code_parse(uint32_t code, uint32_t *seed, difficulty_t *difficulty);
+
+// Writes the code as PUZZLE_CODE_DIGITS digits plus a terminator.
+void puzzle_code_format(uint32_t code, char text[PUZZLE_CODE_DIGITS + 1]);
+
+// Small LRU of recently played puzzles by code, packed like bank records,
+// so replaying one skips the generator.
+#ifndef PUZZLE_CACHE_SIZE
+#define PUZZLE_CACHE_SIZE 4
+#endif
+
+bool puzzle_cache_get(uint32_t code, sudoku_puzzle_t *puzzle);
+void puzzle_cache_put(uint32_t code, const sudoku_puzzle_t *puzzle);
+
+#endif // CODE_H_DC6400EE0413FD91
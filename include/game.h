@@ -18,6 +18,8 @@ typedef enum {
 typedef enum {
     GAME_STATE_INTRO,
     GAME_STATE_MENU,
+    GAME_STATE_CODE_ENTRY,
+    GAME_STATE_GENERATING,
     GAME_STATE_PLAYING,
     GAME_STATE_PAUSED,
 } game_screen_state_t;
@@ -30,7 +32,11 @@ static const char *DIFFICULTY_NAMES[] = {
 
 typedef struct {
     sudoku_puzzle_t puzzle;
+    // Tracks puzzle.grid; every edit goes through conflict_index_set().
+    conflict_index_t conflicts;
     difficulty_t difficulty;
+    // Puzzle code of the board (see code.h).
+    uint32_t code;
     bool solved;
 
     uint8_t cursor_row;
@@ -58,6 +64,8 @@ static const struct {
 };
 
 void game_init();
+// Background work for core1; returns false when there is none.
+bool game_idle();
 void game_new_puzzle(difficulty_t difficulty);
 void game_update();
 
@@ -0,0 +1,178 @@
+#ifndef GENERATOR_H_7C2E51A09D3F84B6
+#define GENERATOR_H_7C2E51A09D3F84B6
+
+#include "game.h"
+#include "grader.h"
+#include "sudoku.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Default work budget for one generator_step() call, in solver nodes and
+// grader steps. A slice is a few carving attempts and fits comfortably
+// inside a frame of the game loop.
+#ifndef GENERATOR_SLICE_NODES
+#define GENERATOR_SLICE_NODES 16
+#endif
+
+// Work budget for one generator_probe_run() call, in solver nodes.
+#ifndef GENERATOR_PROBE_NODES
+#define GENERATOR_PROBE_NODES 64
+#endif
+
+// How many removals may be under test at once, counting from the oldest
+// undecided one. Each test guesses the decisions on the cells before it, so
+// the window must fit the guess bits of carve_test_t.
+#ifndef GENERATOR_WINDOW
+#define GENERATOR_WINDOW 8
+#endif
+
+// Carves tried on one solution before a new one is filled. A solution that
+// keeps missing the tier's easiest technique is rarely unlucky more than a
+// dozen times, and the cap keeps generation from running forever on one
+// that never can.
+#ifndef GENERATOR_MAX_CARVES
+#define GENERATOR_MAX_CARVES 16
+#endif
+
+// Bump whenever a seed would produce a different puzzle than before, so
+// puzzle codes from older builds are refused instead of giving a
+// different board (see code.h). Solver build options that change the
+// search order (engine, kernel, propagation) count as such a change.
+#define GENERATOR_VERSION 3
+
+// A puzzle is a pure function of its seed and difficulty. Seeds are kept
+// short so puzzle codes stay short.
+#define GENERATOR_SEED_BITS 20
+#define GENERATOR_SEEDS (1UL << GENERATOR_SEED_BITS)
+
+typedef enum {
+    GENERATOR_IDLE,
+    GENERATOR_FILLING,
+    GENERATOR_CARVING,
+    GENERATOR_DONE,
+} generator_phase_t;
+
+typedef enum {
+    CARVE_TEST_IDLE,
+    CARVE_TEST_RUNNING,
+    CARVE_TEST_DONE,
+    // Ran on guesses that turned out wrong and did not decide; to be run
+    // again once it is the oldest.
+    CARVE_TEST_RETRY,
+} carve_test_state_t;
+
+// One removal under test. Its board is the settled board without the cell
+// under test and without those of the `depth` undecided cells before it
+// that it guessed would be removed.
+typedef struct {
+    uint8_t state;
+    uint8_t depth;
+    // Guessed decisions on the cells before, bit 0 for the one just before
+    // and a set bit for a removal.
+    uint8_t assumed;
+    bool unique;
+} carve_test_t;
+
+// Tests removals for a generator on another core (or thread), ahead of
+// their turn. The generator posts one board at a time and whoever drives
+// the probe works on it with generator_probe_run(). The probe has its own
+// solver, so the two cores never share search state.
+//
+// The ticket counters are the only fields both sides touch, always through
+// atomics: posted and cancelled are written by the generator's core,
+// finished by the probe's. The board is handed over with posted and the
+// result comes back with finished.
+typedef struct {
+    solver_ctx_t solver;
+    sudoku_puzzle_t puzzle;
+    bool unique;
+    bool running;
+    uint32_t posted;
+    uint32_t finished;
+    uint32_t cancelled;
+    // Generator whose test is posted; only used on the generator's core.
+    const void *owner;
+} generator_probe_t;
+
+// A puzzle under construction. The generator works on its own copy of the
+// puzzle, so cancelling or restarting it never touches a caller's board.
+//
+// Difficulty is a technique tier rather than a number of holes: cells are
+// removed while the puzzle stays within the tier's hardest technique, and
+// a carve that cannot end up needing the tier's easiest one is started
+// over on the same solution, up to GENERATOR_MAX_CARVES times.
+typedef struct {
+    solver_ctx_t *solver;
+    sudoku_puzzle_t puzzle;
+    difficulty_t difficulty;
+    uint32_t seed;
+    technique_t min;
+    technique_t max;
+    generator_phase_t phase;
+    uint8_t positions[81];
+    // positions[0, settled) are decided and applied to `puzzle`, and
+    // positions[settled, next) are under test.
+    uint8_t next;
+    uint8_t settled;
+    uint8_t removed;
+    // Carves started on the current solution.
+    uint8_t carves;
+    // Decisions on the last cells settled, bit 0 for the latest.
+    uint8_t history;
+    // Tests of the cells under test, by index into positions modulo the
+    // window. One runs on the generator's own solver and, with a probe
+    // attached, another on the probe, while finished ones wait their turn:
+    // cells are still decided in shuffled order, so the puzzle is the same
+    // either way. A uniqueness check may be left suspended in the solver
+    // between steps, so the solver must not be used for anything else
+    // while the generator is busy.
+    carve_test_t tests[GENERATOR_WINDOW];
+    uint8_t local;
+    uint8_t remote;
+    uint32_t ticket;
+    generator_probe_t *probe;
+    // Solver nodes spent on this puzzle so far on the generator's own
+    // solver, fills and uniqueness checks together, for benchmarks.
+    uint32_t nodes;
+    // Grade and logical solve path of the puzzle once done.
+    grade_t grade;
+    solve_path_t path;
+} generator_t;
+
+// Starts on the puzzle for `seed`, reseeding the solver from it. The solver
+// must not be used for anything else until the generator is done.
+void generator_start_seed(generator_t *gen, solver_ctx_t *solver,
+                          difficulty_t difficulty, uint32_t seed);
+// Same with a random seed.
+void generator_start(generator_t *gen, solver_ctx_t *solver, difficulty_t difficulty);
+void generator_cancel(generator_t *gen);
+
+// Lends the generator a probe, or takes it back with NULL. Generators may
+// share a probe; the one stepped last gets to use it. Something must keep
+// calling generator_probe_run() on the probe, or the generator waits on
+// it forever. A generator that was never attached must start out zeroed,
+// or at least with a NULL probe.
+void generator_attach(generator_t *gen, generator_probe_t *probe);
+
+void generator_probe_init(generator_probe_t *probe);
+// Works on the posted test for at most `budget` solver nodes. Meant for the
+// other core. Returns false when there was nothing to do.
+bool generator_probe_run(generator_probe_t *probe, uint32_t budget);
+
+// Advances generation until roughly `budget` units of work have been spent,
+// counting solver nodes and grader steps alike. Uniqueness checks stop
+// mid-search when the budget runs out and resume on the next call; fills
+// and grading still run whole. Every call makes progress, even with a
+// budget of zero, unless it is waiting on the probe, in which case it
+// returns at once. Returns the phase reached.
+generator_phase_t generator_step(generator_t *gen, uint32_t budget);
+
+static inline bool generator_busy(const generator_t *gen) {
+    return gen->phase == GENERATOR_FILLING || gen->phase == GENERATOR_CARVING;
+}
+
+// Blocking convenience wrapper for the host tools.
+void generator_create_puzzle(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle,
+                             difficulty_t difficulty, uint32_t seed);
+
+#endif // GENERATOR_H_7C2E51A09D3F84B6
@@ -0,0 +1,78 @@
+#ifndef GRADER_H_2F6D93A1C07B5E48
+#define GRADER_H_2F6D93A1C07B5E48
+
+#include "game.h"
+#include "sudoku.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Solving techniques from easiest to hardest. The grader always applies
+// the easiest one that makes progress, so the hardest technique it used
+// is the hardest one the puzzle needs.
+typedef enum {
+    TECHNIQUE_HIDDEN_SINGLE,
+    TECHNIQUE_NAKED_SINGLE,
+    TECHNIQUE_LOCKED_CANDIDATES,
+    TECHNIQUE_NAKED_SUBSET,
+    TECHNIQUE_HIDDEN_SUBSET,
+    TECHNIQUE_X_WING,
+    TECHNIQUE_SWORDFISH,
+    // Nothing above applies; a human would have to guess.
+    TECHNIQUE_GUESS,
+    TECHNIQUE_COUNT,
+} technique_t;
+
+typedef struct {
+    technique_t hardest;
+    // Sum of the cost of every technique application, for ranking puzzles
+    // within a tier.
+    uint16_t score;
+    // Technique applications made, a rough measure of grading work.
+    uint16_t steps;
+    uint8_t uses[TECHNIQUE_COUNT];
+} grade_t;
+
+// One placement of a logical solve: the cell filled, the hardest technique
+// applied since the previous placement (what it took to see this one), and
+// the grader pass it came in. Three bytes, so a whole path is 244.
+typedef struct {
+    uint8_t cell;
+    uint8_t technique;
+    uint8_t step;
+} path_step_t;
+
+// Every empty cell in an order a player can follow: each one can be
+// deduced from the givens and the cells before it. Where the techniques
+// run out, the next cell is a guess revealed from the solution.
+typedef struct {
+    path_step_t steps[81];
+    uint8_t length;
+} solve_path_t;
+
+// Solves the puzzle logically, without touching it. Returns false if the
+// givens contradict each other or the puzzle has no solution. Otherwise
+// fills in grade; the puzzle has a unique solution whenever
+// grade->hardest is below TECHNIQUE_GUESS.
+bool grader_grade(const sudoku_puzzle_t *puzzle, grade_t *grade);
+
+// grader_grade() for a tier check: also returns false, as soon as it is
+// known, if the puzzle needs a technique harder than max. Techniques past
+// max are never tried, so a reject costs no more than the passes up to it.
+bool grader_grade_within(const sudoku_puzzle_t *puzzle, technique_t max,
+                         grade_t *grade);
+
+// grader_grade() that also records the solve path. Guesses take their digit
+// from puzzle->solution, so without one the path stops at the first guess.
+// The grade is the same as grader_grade() gives.
+bool grader_solve_path(const sudoku_puzzle_t *puzzle, grade_t *grade,
+                       solve_path_t *path);
+
+// Cost of one application of a technique, in the grade's score units.
+uint8_t grader_technique_cost(technique_t technique);
+const char *grader_technique_name(technique_t technique);
+
+// Range of hardest techniques that make up each difficulty tier.
+technique_t grader_tier_min(difficulty_t difficulty);
+technique_t grader_tier_max(difficulty_t difficulty);
+
+#endif // GRADER_H_2F6D93A1C07B5E48
@@ -0,0 +1,39 @@
+#ifndef HINT_H_FDDF80605F457573
+#define HINT_H_FDDF80605F457573
+
+#include "grader.h"
+#include "sudoku.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define HINT_BASE 0xFFU
+
+// Hints follow the puzzle's logical solve path. Filling in correct digits
+// only ever makes deductions easier, so as long as every cell before
+// `next` on the path holds its solution digit, the cell at `next` can be
+// deduced from the board. Most hints are then a short walk forward from
+// `next`; the path is only re-solved when a cell it builds on (a given, or
+// a correct digit from the last re-solve) is changed.
+typedef struct {
+    solve_path_t path;
+    // Position of each cell on the path, or HINT_BASE for cells the path
+    // builds on.
+    uint8_t position[81];
+    uint8_t next;
+    bool stale;
+} hint_t;
+
+// Starts tracking a board. path may be NULL, in which case it is solved
+// here; puzzle must carry its solution.
+void hint_init(hint_t *hint, const sudoku_puzzle_t *puzzle,
+               const solve_path_t *path);
+
+// To be called after every change to a cell of the board.
+void hint_update(hint_t *hint, const sudoku_puzzle_t *puzzle, int cell);
+
+// The next cell the player can deduce, with the technique it takes.
+// Returns -1 once every cell holds its solution digit.
+int hint_next(hint_t *hint, const sudoku_puzzle_t *puzzle,
+              technique_t *technique);
+
+#endif // HINT_H_FDDF80605F457573
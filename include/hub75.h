@@ -1,11 +1,21 @@
 #ifndef HUB75_H_95995C08A1CA79D5
 #define HUB75_H_95995C08A1CA79D5
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #define HUB75_PANEL_WIDTH  32
 #define HUB75_PANEL_HEIGHT 32
+// Bits per channel shown on the panel, 4 to 10. Colours are still given
+// as 8-bit values and gamma-corrected to this depth.
+#ifndef HUB75_COLOR_DEPTH
 #define HUB75_COLOR_DEPTH  8
+#endif
+// Frames per second the BCM timing is laid out for. The least significant
+// plane gets whatever OE time fits, so higher rates trade brightness.
+#ifndef HUB75_REFRESH_HZ
+#define HUB75_REFRESH_HZ   240
+#endif
 
 #define COLOR_RED 255, 0, 0
 #define COLOR_RED 255, 0, 0
@@ -18,14 +28,38 @@
 #define COLOR_PURPLE  64, 0, 255
 #define COLOR_WHITE 255, 255, 255
 
+// Starts scanning the panel with PIO and DMA.
 void hub75_init();
-void hub75_refresh();
-void hub75_spin();
 
-void lock_refresh();
-void unlock_refresh();
+typedef struct {
+    // Frames per second, measured since hub75_init().
+    float refresh_hz;
+    // Share of the time the panel is lit.
+    float duty;
+    // OE time of the least significant plane.
+    float lsb_ns;
+} hub75_timing_t;
+
+void hub75_get_timing(hub75_timing_t *timing);
+
+// Drawing goes to a back buffer that is never scanned, so it never waits
+// and the panel never shows a half-drawn frame.
 void hub75_set_pixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b);
 void hub75_clear();
+// Hands what was drawn since the last call to the scan, to go up at the
+// next frame boundary. Never waits: while the previous frame has not been
+// taken up yet it returns false, and what was drawn is kept for the next
+// call. Drawing carries on from the presented frame.
+bool hub75_present();
+
+// Indexed mode: 4 bits per pixel into a palette of HUB75_PALETTE_SIZE
+// colours, expanded to the panel when presented. Changing a palette entry
+// recolours every pixel using it without redrawing. While it is on,
+// hub75_set_pixel() has no effect; switching either way clears the frame.
+#define HUB75_PALETTE_SIZE 16
+void hub75_set_indexed(bool indexed);
+void hub75_set_palette(uint8_t index, uint8_t r, uint8_t g, uint8_t b);
+void hub75_set_index(uint8_t x, uint8_t y, uint8_t index);
 
 void hub75_set_cursor(uint8_t x, uint8_t y);
 void hub75_update(void);
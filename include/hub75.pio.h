@@ -8,53 +8,114 @@
 #include "hardware/pio.h"
 #endif
 
-// ----- //
-// hub75 //
-// ----- //
+// ---------- //
+// hub75_data //
+// ---------- //
 
-#define hub75_wrap_target 0
-#define hub75_wrap 1
-#define hub75_pio_version 0
+#define hub75_data_wrap_target 0
+#define hub75_data_wrap 4
+#define hub75_data_pio_version 0
 
-static const uint16_t hub75_program_instructions[] = {
+static const uint16_t hub75_data_program_instructions[] = {
             //     .wrap_target
-    0x6006, //  0: out    pins, 6         side 0
-    0xb042, //  1: nop                    side 1
+    0xe03f, //  0: set    x, 31           side 0
+    0x6006, //  1: out    pins, 6         side 0
+    0x1041, //  2: jmp    x--, 1          side 1
+    0xc000, //  3: irq    nowait 0        side 0
+    0x20c1, //  4: wait   1 irq, 1        side 0
             //     .wrap
 };
 
 #if !PICO_NO_HARDWARE
-static const struct pio_program hub75_program = {
-    .instructions = hub75_program_instructions,
-    .length = 2,
+static const struct pio_program hub75_data_program = {
+    .instructions = hub75_data_program_instructions,
+    .length = 5,
     .origin = -1,
-    .pio_version = hub75_pio_version,
+    .pio_version = hub75_data_pio_version,
 #if PICO_PIO_VERSION > 0
     .used_gpio_ranges = 0x0
 #endif
 };
 
-static inline pio_sm_config hub75_program_get_default_config(uint offset) {
+static inline pio_sm_config hub75_data_program_get_default_config(uint offset) {
     pio_sm_config c = pio_get_default_sm_config();
-    sm_config_set_wrap(&c, offset + hub75_wrap_target, offset + hub75_wrap);
+    sm_config_set_wrap(&c, offset + hub75_data_wrap_target, offset + hub75_data_wrap);
     sm_config_set_sideset(&c, 1, false, false);
     return c;
 }
 
-    static inline void hub75_program_init(PIO pio, unsigned sm, unsigned offset, unsigned base_pin) {
-        for (int i = 0; i < 7; ++i) {
-            pio_gpio_init(pio, base_pin + i);
+    static inline void hub75_data_program_init(PIO pio, unsigned sm, unsigned offset, unsigned rgb_base, unsigned clk_pin, float div) {
+        for (unsigned i = 0; i < 6; ++i) {
+            pio_gpio_init(pio, rgb_base + i);
         }
-        pio_sm_set_consecutive_pindirs(pio, sm, base_pin, 7, true);
-        pio_sm_config c = hub75_program_get_default_config(offset);
-        sm_config_set_out_pins(&c, base_pin, 6);
-        sm_config_set_sideset_pins(&c, base_pin + 6);
+        pio_gpio_init(pio, clk_pin);
+        pio_sm_set_consecutive_pindirs(pio, sm, rgb_base, 6, true);
+        pio_sm_set_consecutive_pindirs(pio, sm, clk_pin, 1, true);
+        pio_sm_config c = hub75_data_program_get_default_config(offset);
+        sm_config_set_out_pins(&c, rgb_base, 6);
+        sm_config_set_sideset_pins(&c, clk_pin);
         sm_config_set_out_shift(&c, true, true, 6);
         sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
-        sm_config_set_clkdiv(&c, 4.f);
+        sm_config_set_clkdiv(&c, div);
         pio_sm_init(pio, sm, offset, &c);
-        pio_sm_set_enabled(pio, sm, true);
     }
 
 #endif
 
+// --------- //
+// hub75_row //
+// --------- //
+
+#define hub75_row_wrap_target 0
+#define hub75_row_wrap 4
+#define hub75_row_pio_version 0
+
+static const uint16_t hub75_row_program_instructions[] = {
+            //     .wrap_target
+    0x7005, //  0: out    pins, 5         side 2
+    0x30c0, //  1: wait   1 irq, 0        side 2
+    0x7b3b, //  2: out    x, 27           side 3 [3]
+    0xd001, //  3: irq    nowait 1        side 2
+    0x0044, //  4: jmp    x--, 4          side 0
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program hub75_row_program = {
+    .instructions = hub75_row_program_instructions,
+    .length = 5,
+    .origin = -1,
+    .pio_version = hub75_row_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config hub75_row_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + hub75_row_wrap_target, offset + hub75_row_wrap);
+    sm_config_set_sideset(&c, 2, false, false);
+    return c;
+}
+
+    // The address is written to five pins from addr_base, but only those in
+    // addr_mask are handed to the PIO; the others keep their function.
+    static inline void hub75_row_program_init(PIO pio, unsigned sm, unsigned offset, unsigned addr_base, uint32_t addr_mask, unsigned lat_pin, float div) {
+        const uint32_t pins = addr_mask | (3U << lat_pin);
+        for (unsigned i = 0; i < 32; ++i) {
+            if (pins & (1U << i)) {
+                pio_gpio_init(pio, i);
+            }
+        }
+        pio_sm_set_pins_with_mask(pio, sm, 2U << lat_pin, pins);
+        pio_sm_set_pindirs_with_mask(pio, sm, pins, pins);
+        pio_sm_config c = hub75_row_program_get_default_config(offset);
+        sm_config_set_out_pins(&c, addr_base, 5);
+        sm_config_set_sideset_pins(&c, lat_pin);
+        sm_config_set_out_shift(&c, true, true, 32);
+        sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+        sm_config_set_clkdiv(&c, div);
+        pio_sm_init(pio, sm, offset, &c);
+    }
+
+#endif
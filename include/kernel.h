@@ -0,0 +1,37 @@
+#ifndef KERNEL_H_5B19E07C3A8D24F1
+#define KERNEL_H_5B19E07C3A8D24F1
+
+#include "sudoku.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Candidate masks for the whole board, one 16-lane row per board row so a
+// row is a single wide register (or a handful of 32-bit words). The three
+// box columns of a row sit in separate 4-lane groups, which keeps every
+// unit reduction a fixed shuffle: column c lives in lane (c / 3) * 4 + c % 3
+// and lanes 3, 7, 11..15 are always zero.
+typedef struct {
+    uint16_t cand[9][16] __attribute__((aligned(32)));
+} kernel_board_t;
+
+static inline int kernel_lane(int col) { return (col / 3) * 4 + col % 3; }
+
+void kernel_load(kernel_board_t *board, const sudoku_puzzle_t *puzzle);
+void kernel_store(const kernel_board_t *board, sudoku_puzzle_t *puzzle);
+
+// Eliminates candidates seen by placed digits and fixes naked and hidden
+// singles across the whole board, a row at a time, until nothing changes.
+// Only the classic row, column and box units are used. That stays sound
+// under variant rules, whose solutions satisfy them too, just weaker.
+// Returns false on a contradiction: an empty cell, a digit placed twice in
+// a unit, a digit with nowhere to go, or a cell forced to two digits.
+bool kernel_propagate(kernel_board_t *board);
+
+// Runs the kernel over the puzzle and writes every forced digit into its
+// grid. Leaves the grid untouched and returns false on a contradiction.
+bool kernel_reduce(sudoku_puzzle_t *puzzle);
+
+// Name of the backend the kernel was built with, for benchmarks.
+const char *kernel_backend();
+
+#endif // KERNEL_H_5B19E07C3A8D24F1
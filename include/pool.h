@@ -0,0 +1,34 @@
+#ifndef POOL_H_E3A90B4C17F26D58
+#define POOL_H_E3A90B4C17F26D58
+
+#include "game.h"
+#include "generator.h"
+#include "grader.h"
+#include "sudoku.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Number of ready puzzles kept per difficulty.
+#ifndef PUZZLE_POOL_DEPTH
+#define PUZZLE_POOL_DEPTH 2
+#endif
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t generated;
+} puzzle_pool_stats_t;
+
+// Background generation borrows `probe` (see generator.h), if not NULL.
+void puzzle_pool_init(generator_probe_t *probe);
+
+// Takes the oldest ready puzzle of a difficulty, with its puzzle code and
+// logical solve path.
+bool puzzle_pool_pop(difficulty_t difficulty, sudoku_puzzle_t *puzzle,
+                     uint32_t *code, solve_path_t *path);
+bool puzzle_pool_refill(uint32_t budget);
+unsigned puzzle_pool_available(difficulty_t difficulty);
+
+void puzzle_pool_get_stats(difficulty_t difficulty, puzzle_pool_stats_t *stats);
+
+#endif // POOL_H_E3A90B4C17F26D58
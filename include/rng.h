@@ -4,23 +4,100 @@
 #ifndef NOPICO
 #include "pico/rand.h"
 #else
-#include <stdlib.h>
 #include <time.h>
 #endif
+#include <stdint.h>
 
+// Per-search random state, so concurrent searches never share a stream.
+// xoshiro128**: four words of state, a few adds, shifts and a rotate per
+// draw, which is cheap on the M33 and fast enough for the solver's inner
+// loop. Hardware entropy is only used to pick a seed.
+typedef struct {
+    uint32_t s[4];
+} rng_t;
 
-static void shuffle_array(uint8_t *array, int size)
+static inline uint32_t rng_rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+// Seeds stream `stream` of `seed`. Seed and stream are run through
+// splitmix64, so neighbouring values still give unrelated streams and the
+// state can never end up all zero. Equal arguments give equal sequences on
+// every build.
+static inline void rng_seed_stream(rng_t *rng, uint32_t seed, uint32_t stream)
+{
+    uint64_t x = ((uint64_t)stream << 32) | seed;
+    for (int i = 0; i < 4; i += 2) {
+        x += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        rng->s[i] = (uint32_t)z;
+        rng->s[i + 1] = (uint32_t)(z >> 32);
+    }
+}
+
+static inline void rng_seed(rng_t *rng, uint32_t seed)
+{
+    rng_seed_stream(rng, seed, 0);
+}
+
+// A value from outside every stream, for picking seeds. The host has no
+// entropy source worth the name, so it makes do with the clock.
+static inline uint32_t rng_entropy(void)
 {
-#ifdef NOPICO
-    srand(time(NULL));
-#endif
-    for (int i = size - 1; i > 0; i--) {
 #ifndef NOPICO
-        uint32_t r = get_rand_32();
+    return get_rand_32();
 #else
-        uint32_t r = (uint32_t)rand();
+    static uint32_t calls;
+    return (uint32_t)time(NULL) ^ (++calls * 0x9E3779B9U);
 #endif
-        uint32_t j = r % (i + 1);
+}
+
+static inline void rng_seed_entropy(rng_t *rng)
+{
+    rng_seed_stream(rng, rng_entropy(), (uint32_t)(uintptr_t)rng);
+}
+
+static inline uint32_t rng_next(rng_t *rng)
+{
+    uint32_t *s = rng->s;
+    uint32_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 11);
+
+    return result;
+}
+
+// Uniform in [0, bound), bound > 0. Lemire's multiply-shift: the high word
+// of a 32x32 product picks the value, and the rare low words that would
+// bias it are redrawn. Needs a division only when a redraw is possible.
+static inline uint32_t rng_below(rng_t *rng, uint32_t bound)
+{
+    uint64_t m = (uint64_t)rng_next(rng) * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound) {
+        uint32_t threshold = -bound % bound;
+        while (low < threshold) {
+            m = (uint64_t)rng_next(rng) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+static inline void rng_shuffle(rng_t *rng, uint8_t *array, int size)
+{
+    for (int i = size - 1; i > 0; i--) {
+        uint32_t j = rng_below(rng, (uint32_t)i + 1);
         uint8_t temp = array[i];
         array[i] = array[j];
         array[j] = temp;
@@ -1,14 +1,143 @@
 #ifndef SUDOKU_H_416AAA1E2ECC5CA3
 #define SUDOKU_H_416AAA1E2ECC5CA3
 
+#include "rng.h"
+#include "units.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+// Solver backend behind solve_puzzle() and has_unique_solution(). The
+// backtracker lives in solver.c, the exact-cover engine in dlx.c.
+#define SUDOKU_ENGINE_BACKTRACK 0
+#define SUDOKU_ENGINE_DLX 1
+
+#ifndef SUDOKU_ENGINE
+#define SUDOKU_ENGINE SUDOKU_ENGINE_BACKTRACK
+#endif
+
+// Branch on the empty cell with the fewest candidates rather than the first
+// empty cell in row-major order. Set to 0 to build the naive search order.
+#ifndef SUDOKU_SEARCH_MRV
+#define SUDOKU_SEARCH_MRV 1
+#endif
+
+// Before branching, place naked and hidden singles until fixpoint, with an
+// undo trail so backtracking stays cheap. Backtracking engine only.
+#ifndef SUDOKU_PROPAGATE
+#define SUDOKU_PROPAGATE 1
+#endif
+
+// Reduce the whole board with the wide propagation kernel in kernel.c before
+// each search starts. Backtracking engine only.
+#ifndef SUDOKU_KERNEL
+#define SUDOKU_KERNEL 1
+#endif
+
 typedef struct {
     uint8_t grid[81];
     uint8_t solution[81];
 } sudoku_puzzle_t;
 
+// Search state of the selected engine. Only solver.c and dlx.c look
+// inside; everyone else just provides the storage.
+#if SUDOKU_ENGINE == SUDOKU_ENGINE_DLX
+#if UNITS_EXTRA_PEERS
+#error "Anti-knight is not an exact cover constraint; use the backtracking engine"
+#endif
+// One column per cell and per (unit, digit); one row per (cell, digit),
+// with a node for its cell and for each unit the cell is in.
+#define DLX_COLUMNS (81 + UNIT_COUNT * 9)
+#define DLX_ROWS 729
+#define DLX_ROW_NODES (1 + CELL_UNITS)
+#define DLX_NODES (DLX_COLUMNS + 1 + DLX_ROWS * DLX_ROW_NODES)
+
+// An open branch point of the search: the column being covered and the row
+// of it selected now (the column itself before the first). tried marks the
+// rows already taken, by position in the column, for the shuffled order.
+typedef struct {
+    uint16_t column;
+    uint16_t row;
+    uint16_t tried;
+} dlx_frame_t;
+
+typedef struct {
+    uint16_t left[DLX_NODES];
+    uint16_t right[DLX_NODES];
+    uint16_t up[DLX_NODES];
+    uint16_t down[DLX_NODES];
+    uint16_t column[DLX_NODES];
+    uint8_t size[DLX_COLUMNS + 1];
+    bool covered[DLX_COLUMNS + 1];
+    uint16_t chosen[81];
+    int depth;
+    // Each frame covers a distinct cell column, so 81 always suffice.
+    dlx_frame_t stack[81];
+    uint8_t stack_len;
+} solver_engine_t;
+#else
+// An open branch point of the search: the cell branched on, the trail
+// length before its node propagated and after, and the digits not tried
+// yet.
+typedef struct {
+    uint8_t cell;
+    uint8_t mark;
+    uint8_t branch;
+    uint16_t untried;
+} solver_frame_t;
+
+typedef struct {
+    // Digits placed in each unit, as 9-bit masks.
+    uint16_t units[UNIT_COUNT];
+#if SUDOKU_SEARCH_MRV
+    // Empty cells bucketed by candidate count.
+    uint8_t count[81];
+    uint8_t next[81];
+    uint8_t prev[81];
+    uint8_t head[10];
+#endif
+    // Cells placed during the search, in order, for undo.
+    uint8_t trail[81];
+    uint8_t trail_len;
+    // Each frame fills a distinct cell, so 81 always suffice.
+    solver_frame_t stack[81];
+    uint8_t stack_len;
+    // Private copy that uniqueness checks run on, so the caller's puzzle
+    // may change while a check is suspended.
+    sudoku_puzzle_t work;
+} solver_engine_t;
+#endif
+
+// Everything one search needs. Contexts are independent, so searches on
+// different contexts may run concurrently (both cores, or host threads).
+// Large enough that callers should give it static storage.
+//
+// The search does not recurse: its trail and branch stack are fixed-size
+// arrays in here, so sizeof(solver_ctx_t) is all the memory it ever uses
+// and its C stack depth is the same for every puzzle.
+typedef struct {
+    rng_t rng;
+    int solution_count;
+    int max_solutions;
+    uint32_t node_count;
+    // A suspended uniqueness check is in progress.
+    bool searching;
+    solver_engine_t engine;
+} solver_ctx_t;
+
+// Most bytes one context may take, checked at compile time. The firmware
+// keeps one for the game and one for the puzzle pool, so growth shows up
+// here rather than as a RAM overflow at link time.
+#ifndef SOLVER_CTX_BUDGET
+#if SUDOKU_ENGINE == SUDOKU_ENGINE_DLX
+#define SOLVER_CTX_BUDGET 65536
+#else
+#define SOLVER_CTX_BUDGET 1536
+#endif
+#endif
+_Static_assert(sizeof(solver_ctx_t) <= SOLVER_CTX_BUDGET,
+               "solver context outgrew its memory budget");
+
 void clear(sudoku_puzzle_t *puzzle);
 
 uint8_t get(sudoku_puzzle_t *puzzle, int row, int col);
@@ -19,8 +148,88 @@ bool is_valid(sudoku_puzzle_t *puzzle);
 
 bool find_empty_cell(sudoku_puzzle_t *puzzle, int *row, int *col);
 
-bool solve_puzzle(sudoku_puzzle_t *puzzle);
-void fill_diagonal_boxes(sudoku_puzzle_t *puzzle);
-bool has_unique_solution(sudoku_puzzle_t *puzzle);
+// How often each digit occurs in each unit of a board being played, kept
+// current by conflict_index_set() so that asking whether the board is solved
+// or whether a cell clashes never scans the grid.
+typedef struct {
+    uint8_t count[UNIT_COUNT][9];
+    // Non-empty cells.
+    uint8_t filled;
+    // Digits in excess of one per unit, summed over all units.
+    uint16_t excess;
+#if UNITS_EXTRA_PEERS
+    // Pairs of extra peers holding the same digit.
+    uint16_t extra_clashes;
+#endif
+} conflict_index_t;
+
+void conflict_index_init(conflict_index_t *index, const sudoku_puzzle_t *puzzle);
+
+// set() that keeps the index in step.
+void conflict_index_set(conflict_index_t *index, sudoku_puzzle_t *puzzle,
+                        int row, int col, uint8_t value);
+
+// Whether the cell's digit also appears among its peers.
+bool conflict_index_cell(const conflict_index_t *index,
+                         const sudoku_puzzle_t *puzzle, int cell);
+
+static inline bool conflict_index_clean(const conflict_index_t *index) {
+#if UNITS_EXTRA_PEERS
+    return index->excess == 0 && index->extra_clashes == 0;
+#else
+    return index->excess == 0;
+#endif
+}
+
+// Full and clean is exactly is_valid() on a full grid.
+static inline bool conflict_index_solved(const conflict_index_t *index) {
+    return index->filled == 81 && conflict_index_clean(index);
+}
+
+void solver_init(solver_ctx_t *ctx);
+// Fixes the context's random choices, so the same seed (and stream) and
+// calls give the same solutions and puzzles. solver_init() seeds from
+// entropy.
+void solver_seed(solver_ctx_t *ctx, uint32_t seed);
+void solver_seed_stream(solver_ctx_t *ctx, uint32_t seed, uint32_t stream);
+
+bool solve_puzzle(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle);
+void fill_diagonal_boxes(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle);
+bool has_unique_solution(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle);
+
+// has_unique_solution() in slices: begin() takes a copy of the puzzle, then
+// each step() visits at most `budget` search nodes and returns true once the
+// answer is in, which result() then gives. Any other search on the same
+// context abandons the check; there is nothing to clean up.
+void solver_unique_begin(solver_ctx_t *ctx, const sudoku_puzzle_t *puzzle);
+bool solver_unique_step(solver_ctx_t *ctx, uint32_t budget);
+bool solver_unique_result(const solver_ctx_t *ctx);
+
+// Search nodes visited by the most recent solve_puzzle() or
+// has_unique_solution() call on ctx.
+uint32_t solver_node_count(const solver_ctx_t *ctx);
+
+#ifdef NOPICO
+// Host-only batch versions (batch.c) that run SOLVER_BATCH_LANES puzzles
+// at once, one per SIMD lane. Results go to the matching entry of
+// solved/unique and the number of hits is returned, or
+// SOLVER_BATCH_FAILED with every result false if the lanes' working memory
+// could not be allocated. Digits are tried in order, so the solutions are
+// deterministic rather than shuffled.
+#define SOLVER_BATCH_FAILED SIZE_MAX
+
+// One vector register of 16-bit lanes.
+#ifndef SOLVER_BATCH_LANES
+#ifdef __AVX2__
+#define SOLVER_BATCH_LANES 16
+#else
+#define SOLVER_BATCH_LANES 8
+#endif
+#endif
+
+size_t solve_puzzle_batch(sudoku_puzzle_t *puzzles, size_t count, bool *solved);
+size_t has_unique_solution_batch(const sudoku_puzzle_t *puzzles, size_t count,
+                                 bool *unique);
+#endif
 
 #endif // SUDOKU_H_416AAA1E2ECC5CA3
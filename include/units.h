@@ -0,0 +1,78 @@
+#ifndef UNITS_H_C84E2F19A6B73D05
+#define UNITS_H_C84E2F19A6B73D05
+
+#include <stdint.h>
+
+// Rule variants layered on top of the classic row, column and box units.
+// Each one only adds entries to the tables below, so the solvers, the
+// grader and the validity checks pick it up without changes of their own.
+//
+// X-Sudoku: both main diagonals hold every digit once.
+#ifndef SUDOKU_VARIANT_X
+#define SUDOKU_VARIANT_X 0
+#endif
+
+// Windoku: four extra boxes at rows and columns 1..3 and 5..7.
+#ifndef SUDOKU_VARIANT_WINDOKU
+#define SUDOKU_VARIANT_WINDOKU 0
+#endif
+
+// Anti-knight: cells a chess knight's move apart never hold the same digit.
+// That is not a unit, so it only shows up as extra peers.
+#ifndef SUDOKU_VARIANT_ANTI_KNIGHT
+#define SUDOKU_VARIANT_ANTI_KNIGHT 0
+#endif
+
+#define UNITS_CLASSIC                                                          \
+    (!SUDOKU_VARIANT_X && !SUDOKU_VARIANT_WINDOKU && !SUDOKU_VARIANT_ANTI_KNIGHT)
+
+// Units 0..8 are rows, 9..17 columns, 18..26 boxes, then the variant units.
+#define UNIT_ROWS 0
+#define UNIT_COLS 9
+#define UNIT_BOXES 18
+#define UNIT_DIAGONALS 27
+#define UNIT_WINDOWS (UNIT_DIAGONALS + 2 * SUDOKU_VARIANT_X)
+#define UNIT_COUNT (UNIT_WINDOWS + 4 * SUDOKU_VARIANT_WINDOKU)
+
+// Most units a single cell belongs to. Cells in fewer repeat their row
+// unit to fill the slot, which is harmless to every mask-based caller.
+#define CELL_UNITS (3 + 2 * SUDOKU_VARIANT_X + SUDOKU_VARIANT_WINDOKU)
+
+// A set of cells, one word per band of three rows: cell 27 * band + i is
+// bit i of band[band].
+typedef struct {
+    uint32_t band[3];
+} cellset_t;
+
+// Runs the statement that follows once for each cell of the set, in cell
+// order, with the cell index in `cell`.
+#define CELLSET_FOR_EACH(cell, set)                                            \
+    for (int band_ = 0, cell; band_ < 3; band_++)                              \
+        for (uint32_t bits_ = (set).band[band_];                               \
+             bits_ && (cell = band_ * 27 + __builtin_ctz(bits_), 1);           \
+             bits_ &= bits_ - 1)
+
+// Literal tables written by tools/units_gen.c and kept in flash.
+extern const uint8_t unit_cells[UNIT_COUNT][9];
+extern const uint8_t cell_units[81][CELL_UNITS];
+extern const uint8_t cell_box[81];
+
+// The cells that may not share a digit with a cell are its 20 classic peers
+// (same row, column or box) plus, with variants, its variant peers.
+#define CELL_PEERS 20
+extern const uint8_t cell_peers[81][CELL_PEERS];
+
+#if !UNITS_CLASSIC
+extern const cellset_t cell_variant_peers[81];
+#endif
+
+#if SUDOKU_VARIANT_ANTI_KNIGHT
+#define UNITS_EXTRA_PEERS 1
+// The variant peers that share no unit with the cell, which unit masks
+// miss.
+extern const cellset_t cell_extra_peers[81];
+#else
+#define UNITS_EXTRA_PEERS 0
+#endif
+
+#endif // UNITS_H_C84E2F19A6B73D05
@@ -0,0 +1,237 @@
+#include "bank.h"
+#include <string.h>
+
+#ifdef NOPICO
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static uint32_t read_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static uint16_t read_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t crc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFU;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & -(crc & 1U));
+        }
+    }
+    return ~crc;
+}
+
+void bank_encode_puzzle(const sudoku_puzzle_t *puzzle,
+                        uint8_t record[BANK_RECORD_SIZE]) {
+    memset(record, 0, BANK_RECORD_SIZE);
+
+    for (int i = 0; i < 81; i++) {
+        if (puzzle->grid[i] != 0) {
+            record[i / 8] |= (uint8_t)(1U << (i % 8));
+        }
+    }
+
+    uint8_t *solution = record + BANK_MASK_BYTES;
+    for (int group = 0; group < 27; group++) {
+        const uint8_t *digits = &puzzle->solution[group * 3];
+        unsigned value = (digits[0] - 1U) * 81 + (digits[1] - 1U) * 9 +
+                         (digits[2] - 1U);
+        unsigned bit = group * 10;
+        for (int k = 0; k < 10; k++, bit++) {
+            if (value & (1U << k)) {
+                solution[bit / 8] |= (uint8_t)(1U << (bit % 8));
+            }
+        }
+    }
+}
+
+bool bank_decode_puzzle(const uint8_t record[BANK_RECORD_SIZE],
+                        sudoku_puzzle_t *puzzle) {
+    const uint8_t *solution = record + BANK_MASK_BYTES;
+
+    // The encoder leaves the padding in the last byte of each field clear.
+    if ((record[BANK_MASK_BYTES - 1] >> (81 % 8)) != 0 ||
+        (solution[BANK_SOLUTION_BYTES - 1] >> (270 % 8)) != 0) {
+        return false;
+    }
+
+    for (int group = 0; group < 27; group++) {
+        unsigned bit = group * 10;
+        unsigned value = 0;
+        for (int k = 0; k < 10; k++, bit++) {
+            value |= ((solution[bit / 8] >> (bit % 8)) & 1U) << k;
+        }
+        if (value >= 729) {
+            return false;
+        }
+        uint8_t *digits = &puzzle->solution[group * 3];
+        digits[0] = (uint8_t)(value / 81 + 1);
+        digits[1] = (uint8_t)(value / 9 % 9 + 1);
+        digits[2] = (uint8_t)(value % 9 + 1);
+    }
+
+    for (int i = 0; i < 81; i++) {
+        bool given = (record[i / 8] >> (i % 8)) & 1U;
+        puzzle->grid[i] = given ? puzzle->solution[i] : 0;
+    }
+    return true;
+}
+
+bool bank_open(bank_t *bank, const uint8_t *data, size_t size) {
+    memset(bank, 0, sizeof(*bank));
+    if (size < BANK_HEADER_SIZE || memcmp(data, BANK_MAGIC, 4) != 0 ||
+        read_u16(data + 4) != BANK_VERSION ||
+        read_u16(data + 6) != BANK_RECORD_SIZE) {
+        return false;
+    }
+
+    const uint8_t *index = data + 8;
+    for (int d = DIFFICULTY_BEGIN; d < DIFFICULTY_COUNT; d++) {
+        uint32_t count = read_u32(index + d * 4);
+        uint32_t offset = read_u32(index + (DIFFICULTY_COUNT + d) * 4);
+        if (offset < BANK_HEADER_SIZE || offset > size ||
+            count > (size - offset) / BANK_RECORD_SIZE) {
+            return false;
+        }
+        bank->count[d] = count;
+        bank->offset[d] = offset;
+    }
+
+    bank->crc = read_u32(data + BANK_HEADER_SIZE - 4);
+    bank->data = data;
+    bank->size = size;
+    return true;
+}
+
+// Checks the payload CRC. This touches every byte, so it is kept separate
+// from bank_open() and is meant for load time on the host or a one-off
+// self-test on the device.
+bool bank_verify(const bank_t *bank) {
+    if (!bank->data) {
+        return false;
+    }
+    return crc32(bank->data + BANK_HEADER_SIZE,
+                 bank->size - BANK_HEADER_SIZE) == bank->crc;
+}
+
+uint32_t bank_count(const bank_t *bank, difficulty_t difficulty) {
+    if (difficulty >= DIFFICULTY_COUNT) {
+        return 0;
+    }
+    return bank->count[difficulty];
+}
+
+bool bank_get(const bank_t *bank, difficulty_t difficulty, uint32_t index,
+              sudoku_puzzle_t *puzzle) {
+    if (index >= bank_count(bank, difficulty)) {
+        return false;
+    }
+    const uint8_t *record =
+        bank->data + bank->offset[difficulty] + (size_t)index * BANK_RECORD_SIZE;
+    return bank_decode_puzzle(record, puzzle);
+}
+
+#ifdef NOPICO
+bool bank_map_file(bank_t *bank, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    if (!bank_open(bank, data, (size_t)st.st_size)) {
+        munmap(data, (size_t)st.st_size);
+        return false;
+    }
+    return true;
+}
+
+void bank_unmap(bank_t *bank) {
+    if (bank->data) {
+        munmap((void *)bank->data, bank->size);
+    }
+    memset(bank, 0, sizeof(*bank));
+}
+
+static void write_u32(uint8_t *p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+bool bank_writer_open(bank_writer_t *writer,
+                      const uint32_t count[DIFFICULTY_COUNT]) {
+    memset(writer, 0, sizeof(*writer));
+
+    size_t offset = BANK_HEADER_SIZE;
+    for (int d = DIFFICULTY_BEGIN; d < DIFFICULTY_COUNT; d++) {
+        writer->count[d] = count[d];
+        writer->offset[d] = (uint32_t)offset;
+        offset += (size_t)count[d] * BANK_RECORD_SIZE;
+    }
+
+    writer->size = offset;
+    writer->data = calloc(1, writer->size);
+    return writer->data != NULL;
+}
+
+// Slots are disjoint, so threads may fill different ones concurrently.
+bool bank_writer_put(bank_writer_t *writer, difficulty_t difficulty,
+                     uint32_t index, const sudoku_puzzle_t *puzzle) {
+    if (difficulty >= DIFFICULTY_COUNT || index >= writer->count[difficulty]) {
+        return false;
+    }
+    bank_encode_puzzle(puzzle, writer->data + writer->offset[difficulty] +
+                                   (size_t)index * BANK_RECORD_SIZE);
+    return true;
+}
+
+bool bank_writer_save(bank_writer_t *writer, const char *path) {
+    uint8_t *header = writer->data;
+    memcpy(header, BANK_MAGIC, 4);
+    header[4] = BANK_VERSION & 0xFF;
+    header[5] = BANK_VERSION >> 8;
+    header[6] = BANK_RECORD_SIZE & 0xFF;
+    header[7] = BANK_RECORD_SIZE >> 8;
+    for (int d = DIFFICULTY_BEGIN; d < DIFFICULTY_COUNT; d++) {
+        write_u32(header + 8 + d * 4, writer->count[d]);
+        write_u32(header + 8 + (DIFFICULTY_COUNT + d) * 4, writer->offset[d]);
+    }
+    write_u32(header + BANK_HEADER_SIZE - 4,
+              crc32(writer->data + BANK_HEADER_SIZE,
+                    writer->size - BANK_HEADER_SIZE));
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(writer->data, 1, writer->size, file) == writer->size;
+    return (fclose(file) == 0) && ok;
+}
+
+void bank_writer_close(bank_writer_t *writer) {
+    free(writer->data);
+    memset(writer, 0, sizeof(*writer));
+}
+#endif
@@ -0,0 +1,264 @@
+#include "sudoku.h"
+
+#ifdef NOPICO
+
+#include <stdlib.h>
+#include <string.h>
+
+// Solves SOLVER_BATCH_LANES independent puzzles side by side. Lane l of
+// every vector belongs to the puzzle running in that lane, so a cell's
+// candidates across the whole batch are one vector and propagation runs
+// for all lanes with the same instructions. Only branching and
+// backtracking are per lane, each lane keeping its own stack; a lane that
+// finishes is refilled with the next puzzle straight away.
+typedef uint16_t lanes_t __attribute__((vector_size(SOLVER_BATCH_LANES * 2)));
+
+// Vectors wider than the target's registers are passed differently with and
+// without AVX. Every function taking one here is static, so that is moot.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#define ALL_CANDIDATES 0x1FF
+#define LANE_IDLE SIZE_MAX
+
+typedef struct {
+    uint16_t cand[81];
+} lane_frame_t;
+
+typedef struct {
+    lanes_t cand[81];
+    lane_frame_t stack[SOLVER_BATCH_LANES][81];
+    uint8_t depth[SOLVER_BATCH_LANES];
+    uint8_t solutions[SOLVER_BATCH_LANES];
+    size_t puzzle[SOLVER_BATCH_LANES];
+} batch_t;
+
+// aligned_alloc() wants the size to be a multiple of the alignment.
+_Static_assert(sizeof(batch_t) % sizeof(lanes_t) == 0,
+               "batch_t must be a whole number of vectors");
+
+static inline lanes_t lanes_mask(lanes_t cond) { return (lanes_t)cond; }
+
+static inline lanes_t popcount9(lanes_t x) {
+    x = x - ((x >> 1) & 0x5555);
+    x = (x & 0x3333) + ((x >> 2) & 0x3333);
+    x = (x + (x >> 4)) & 0x0F0F;
+    return (x + (x >> 8)) & 0x1F;
+}
+
+static inline bool lanes_any(lanes_t v) {
+    uint16_t any = 0;
+    for (int l = 0; l < SOLVER_BATCH_LANES; l++) {
+        any |= v[l];
+    }
+    return any != 0;
+}
+
+// Digits seen at least once and at least twice in each unit.
+static void tally_units(const lanes_t *cand, lanes_t *once, lanes_t *twice) {
+    for (int u = 0; u < UNIT_COUNT; u++) {
+        lanes_t o = {0}, t = {0};
+        for (int k = 0; k < 9; k++) {
+            lanes_t c = cand[unit_cells[u][k]];
+            t |= o & c;
+            o |= c;
+        }
+        once[u] = o;
+        twice[u] = t;
+    }
+}
+
+// Naked and hidden singles for every lane at once, until no lane changes.
+// Returns a vector that is nonzero in each lane that hit a contradiction.
+static lanes_t propagate(lanes_t *cand) {
+    lanes_t dead = {0};
+    lanes_t once[UNIT_COUNT], twice[UNIT_COUNT];
+    lanes_t single[81], placed[81];
+    bool changed = true;
+
+    while (changed) {
+        lanes_t diff = {0};
+
+        for (int cell = 0; cell < 81; cell++) {
+            lanes_t c = cand[cell];
+            single[cell] = lanes_mask((c & (c - 1)) == 0);
+            placed[cell] = c & single[cell];
+            dead |= lanes_mask(c == 0);
+        }
+
+        tally_units(placed, once, twice);
+        for (int u = 0; u < UNIT_COUNT; u++) {
+            dead |= twice[u];
+        }
+        for (int cell = 0; cell < 81; cell++) {
+            lanes_t seen = {0};
+            for (int i = 0; i < CELL_UNITS; i++) {
+                seen |= once[cell_units[cell][i]];
+            }
+#if UNITS_EXTRA_PEERS
+            lanes_t near = {0};
+            CELLSET_FOR_EACH(peer, cell_extra_peers[cell]) {
+                near |= placed[peer];
+            }
+            dead |= placed[cell] & near;
+            seen |= near;
+#endif
+            lanes_t next = placed[cell] | (cand[cell] & ~single[cell] & ~seen);
+            diff |= next ^ cand[cell];
+            cand[cell] = next;
+        }
+
+        tally_units(cand, once, twice);
+        for (int u = 0; u < UNIT_COUNT; u++) {
+            dead |= once[u] ^ ALL_CANDIDATES;
+            once[u] &= ~twice[u];
+        }
+        for (int cell = 0; cell < 81; cell++) {
+            lanes_t c = cand[cell];
+            lanes_t only = {0};
+            for (int i = 0; i < CELL_UNITS; i++) {
+                only |= once[cell_units[cell][i]];
+            }
+            lanes_t hidden = c & only;
+            dead |= hidden & (hidden - 1);
+            lanes_t next = (c & lanes_mask(hidden == 0)) | hidden;
+            diff |= next ^ c;
+            cand[cell] = next;
+        }
+
+        changed = lanes_any(diff);
+    }
+
+    return dead;
+}
+
+static void lane_load(batch_t *b, int lane, const uint16_t *cand) {
+    for (int cell = 0; cell < 81; cell++) {
+        b->cand[cell][lane] = cand[cell];
+    }
+}
+
+static void lane_start(batch_t *b, int lane, const sudoku_puzzle_t *puzzles,
+                       size_t index) {
+    uint16_t cand[81];
+    for (int cell = 0; cell < 81; cell++) {
+        uint8_t num = puzzles[index].grid[cell];
+        cand[cell] = num ? (uint16_t)(1U << (num - 1)) : ALL_CANDIDATES;
+    }
+    lane_load(b, lane, cand);
+    b->depth[lane] = 0;
+    b->solutions[lane] = 0;
+    b->puzzle[lane] = index;
+}
+
+// Pops the lane's most recent alternative. Returns false once the lane's
+// search space is exhausted.
+static bool lane_backtrack(batch_t *b, int lane) {
+    if (b->depth[lane] == 0) {
+        return false;
+    }
+    lane_load(b, lane, b->stack[lane][--b->depth[lane]].cand);
+    return true;
+}
+
+// Tries the lowest candidate of cell, saving the board without it so
+// lane_backtrack() resumes with the remaining candidates.
+static void lane_branch(batch_t *b, int lane, int cell) {
+    lane_frame_t *frame = &b->stack[lane][b->depth[lane]++];
+    for (int i = 0; i < 81; i++) {
+        frame->cand[i] = b->cand[i][lane];
+    }
+    uint16_t cands = frame->cand[cell];
+    uint16_t bit = cands & -cands;
+    frame->cand[cell] = cands & ~bit;
+    b->cand[cell][lane] = bit;
+}
+
+// Runs every puzzle through the lanes, stopping each search at
+// max_solutions. result[i] is set when puzzle i had exactly one solution
+// within that limit; with solutions non-null the first one found is
+// written to its grid.
+static size_t run_batch(const sudoku_puzzle_t *puzzles, size_t count,
+                        int max_solutions, sudoku_puzzle_t *solutions,
+                        bool *result) {
+    batch_t *b = aligned_alloc(sizeof(lanes_t), sizeof(batch_t));
+    if (!b) {
+        memset(result, 0, count * sizeof(bool));
+        return SOLVER_BATCH_FAILED;
+    }
+    size_t next = 0, matched = 0;
+    int active = 0;
+
+    for (int l = 0; l < SOLVER_BATCH_LANES; l++) {
+        if (next < count) {
+            lane_start(b, l, puzzles, next++);
+            active++;
+        } else {
+            b->puzzle[l] = LANE_IDLE;
+        }
+    }
+
+    while (active > 0) {
+        lanes_t dead = propagate(b->cand);
+
+        // Most constrained open cell per lane; a count of 10 means solved.
+        lanes_t best_count = {0}, best_cell = {0};
+        best_count += 10;
+        for (int cell = 0; cell < 81; cell++) {
+            lanes_t n = popcount9(b->cand[cell]);
+            n |= lanes_mask(n <= 1) & 10;
+            lanes_t better = lanes_mask(n < best_count);
+            best_count = (best_count & ~better) | (n & better);
+            best_cell = (best_cell & ~better) | (((lanes_t){0} + (uint16_t)cell) & better);
+        }
+
+        for (int l = 0; l < SOLVER_BATCH_LANES; l++) {
+            size_t index = b->puzzle[l];
+            if (index == LANE_IDLE) {
+                continue;
+            }
+
+            bool more;
+            if (dead[l]) {
+                more = lane_backtrack(b, l);
+            } else if (best_count[l] == 10) {
+                if (b->solutions[l]++ == 0 && solutions) {
+                    for (int cell = 0; cell < 81; cell++) {
+                        solutions[index].grid[cell] =
+                            (uint8_t)__builtin_ctz(b->cand[cell][l]) + 1;
+                    }
+                }
+                more = b->solutions[l] < max_solutions && lane_backtrack(b, l);
+            } else {
+                lane_branch(b, l, best_cell[l]);
+                more = true;
+            }
+
+            if (more) {
+                continue;
+            }
+
+            result[index] = b->solutions[l] == 1;
+            matched += result[index];
+            if (next < count) {
+                lane_start(b, l, puzzles, next++);
+            } else {
+                b->puzzle[l] = LANE_IDLE;
+                active--;
+            }
+        }
+    }
+
+    free(b);
+    return matched;
+}
+
+size_t solve_puzzle_batch(sudoku_puzzle_t *puzzles, size_t count, bool *solved) {
+    return run_batch(puzzles, count, 1, puzzles, solved);
+}
+
+size_t has_unique_solution_batch(const sudoku_puzzle_t *puzzles, size_t count,
+                                 bool *unique) {
+    return run_batch(puzzles, count, 2, NULL, unique);
+}
+
+#endif // NOPICO
@@ -0,0 +1,108 @@
+#include "code.h"
+#include "bank.h"
+#include <string.h>
+
+#define VERSION_SHIFT (GENERATOR_SEED_BITS + 2)
+#define DIFFICULTY_SHIFT GENERATOR_SEED_BITS
+
+_Static_assert(GENERATOR_VERSION > 0 && GENERATOR_VERSION < 16,
+               "generator version must fit the code's 4 bits");
+_Static_assert(DIFFICULTY_COUNT <= 4, "difficulty must fit the code's 2 bits");
+_Static_assert((uint64_t)(1U << (VERSION_SHIFT + 4)) * 10 <= 1000000000ULL,
+               "puzzle code no longer fits in nine digits");
+
+// Damm's quasigroup: folding the digits through it gives 0 exactly when
+// the check digit matches.
+static const uint8_t damm[10][10] = {
+    {0, 3, 1, 7, 5, 9, 8, 6, 4, 2}, {7, 0, 9, 2, 1, 5, 4, 8, 6, 3},
+    {4, 2, 0, 6, 8, 7, 1, 3, 5, 9}, {1, 7, 5, 0, 9, 8, 3, 4, 2, 6},
+    {6, 1, 2, 3, 0, 4, 5, 9, 7, 8}, {3, 6, 7, 4, 2, 0, 9, 5, 8, 1},
+    {5, 8, 6, 9, 7, 2, 0, 1, 3, 4}, {8, 9, 4, 5, 3, 6, 2, 0, 1, 7},
+    {9, 4, 3, 8, 6, 1, 7, 2, 0, 5}, {2, 5, 8, 1, 4, 3, 6, 7, 9, 0},
+};
+
+static uint8_t damm_fold(uint32_t value) {
+    char text[PUZZLE_CODE_DIGITS + 1];
+    puzzle_code_format(value, text);
+
+    uint8_t interim = 0;
+    for (int i = 0; i < PUZZLE_CODE_DIGITS; i++) {
+        interim = damm[interim][text[i] - '0'];
+    }
+    return interim;
+}
+
+uint32_t puzzle_code_make(uint32_t seed, difficulty_t difficulty) {
+    uint32_t payload = ((uint32_t)GENERATOR_VERSION << VERSION_SHIFT) |
+                       ((uint32_t)difficulty << DIFFICULTY_SHIFT) |
+                       (seed & (GENERATOR_SEEDS - 1));
+    return payload * 10 + damm_fold(payload);
+}
+
+bool puzzle_code_parse(uint32_t code, uint32_t *seed, difficulty_t *difficulty) {
+    uint32_t payload = code / 10;
+    if (damm_fold(code) != 0 || payload >> VERSION_SHIFT != GENERATOR_VERSION) {
+        return false;
+    }
+
+    uint32_t level = (payload >> DIFFICULTY_SHIFT) & 3;
+    if (level >= DIFFICULTY_COUNT) {
+        return false;
+    }
+    *difficulty = (difficulty_t)level;
+    *seed = payload & (GENERATOR_SEEDS - 1);
+    return true;
+}
+
+void puzzle_code_format(uint32_t code, char text[PUZZLE_CODE_DIGITS + 1]) {
+    for (int i = PUZZLE_CODE_DIGITS - 1; i >= 0; i--) {
+        text[i] = (char)('0' + code % 10);
+        code /= 10;
+    }
+    text[PUZZLE_CODE_DIGITS] = '\0';
+}
+
+// Most recently used first.
+typedef struct {
+    uint32_t code;
+    uint8_t record[BANK_RECORD_SIZE];
+} cache_entry_t;
+
+static cache_entry_t cache[PUZZLE_CACHE_SIZE];
+static unsigned cache_used;
+
+// Moves entry i to the front, shifting the more recent ones down.
+static void cache_touch(unsigned i) {
+    cache_entry_t entry = cache[i];
+    memmove(&cache[1], &cache[0], i * sizeof(cache_entry_t));
+    cache[0] = entry;
+}
+
+static int cache_find(uint32_t code) {
+    for (unsigned i = 0; i < cache_used; i++) {
+        if (cache[i].code == code) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+bool puzzle_cache_get(uint32_t code, sudoku_puzzle_t *puzzle) {
+    int i = cache_find(code);
+    if (i < 0) {
+        return false;
+    }
+    cache_touch((unsigned)i);
+    return bank_decode_puzzle(cache[0].record, puzzle);
+}
+
+void puzzle_cache_put(uint32_t code, const sudoku_puzzle_t *puzzle) {
+    int i = cache_find(code);
+    if (i < 0) {
+        // Evict the least recent entry once full.
+        i = cache_used < PUZZLE_CACHE_SIZE ? (int)cache_used++ : PUZZLE_CACHE_SIZE - 1;
+    }
+    cache_touch((unsigned)i);
+    cache[0].code = code;
+    bank_encode_puzzle(puzzle, cache[0].record);
+}
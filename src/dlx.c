@@ -0,0 +1,287 @@
+#include "sudoku.h"
+
+#if SUDOKU_ENGINE == SUDOKU_ENGINE_DLX
+
+#include "rng.h"
+#include <string.h>
+
+// Sudoku as exact cover: every candidate placement (cell, digit) is a row
+// that satisfies one constraint per column group: the cell is filled, and
+// the digit appears once in each unit of the cell. Algorithm X over
+// dancing links then finds sets of rows covering every column exactly once.
+//
+// All links live in one fixed arena inside the solver context, indexed by
+// node number. Node 0 is the root, then the column headers, and each matrix
+// row owns DLX_ROW_NODES consecutive nodes starting at DLX_FIRST_ROW_NODE.
+// Cells in fewer than CELL_UNITS units leave their spare nodes unlinked.
+#define DLX_ROOT 0
+#define DLX_FIRST_ROW_NODE (DLX_COLUMNS + 1)
+
+typedef enum {
+    SEARCH_BUSY,
+    SEARCH_FOUND,
+    SEARCH_EXHAUSTED,
+} search_t;
+
+static inline int row_id(int cell, uint8_t num) { return cell * 9 + num - 1; }
+
+static inline uint16_t row_node(int id) {
+    return (uint16_t)(DLX_FIRST_ROW_NODE + id * DLX_ROW_NODES);
+}
+
+static inline int node_row_id(uint16_t node) {
+    return (node - DLX_FIRST_ROW_NODE) / DLX_ROW_NODES;
+}
+
+static void build_matrix(solver_engine_t *e) {
+    for (int c = 0; c <= DLX_COLUMNS; c++) {
+        e->left[c] = (uint16_t)(c == 0 ? DLX_COLUMNS : c - 1);
+        e->right[c] = (uint16_t)(c == DLX_COLUMNS ? 0 : c + 1);
+        e->up[c] = e->down[c] = e->column[c] = (uint16_t)c;
+        e->size[c] = 0;
+        e->covered[c] = false;
+    }
+
+    for (int cell = 0; cell < 81; cell++) {
+        const uint8_t *units = cell_units[cell];
+
+        for (int d = 0; d < 9; d++) {
+            uint16_t cols[DLX_ROW_NODES] = {(uint16_t)(1 + cell)};
+            int n = 1;
+            for (int i = 0; i < CELL_UNITS; i++) {
+                // Padding slots repeat the row unit.
+                if (i == 0 || units[i] != units[0]) {
+                    cols[n++] = (uint16_t)(1 + 81 + units[i] * 9 + d);
+                }
+            }
+            uint16_t base = row_node(cell * 9 + d);
+
+            for (int k = 0; k < n; k++) {
+                uint16_t node = (uint16_t)(base + k);
+                uint16_t c = cols[k];
+
+                e->left[node] = (uint16_t)(base + (k + n - 1) % n);
+                e->right[node] = (uint16_t)(base + (k + 1) % n);
+
+                e->column[node] = c;
+                e->up[node] = e->up[c];
+                e->down[node] = c;
+                e->down[e->up[c]] = node;
+                e->up[c] = node;
+                e->size[c]++;
+            }
+        }
+    }
+
+    e->depth = 0;
+}
+
+static void cover(solver_engine_t *e, uint16_t c) {
+    e->covered[c] = true;
+    e->right[e->left[c]] = e->right[c];
+    e->left[e->right[c]] = e->left[c];
+    for (uint16_t i = e->down[c]; i != c; i = e->down[i]) {
+        for (uint16_t j = e->right[i]; j != i; j = e->right[j]) {
+            e->down[e->up[j]] = e->down[j];
+            e->up[e->down[j]] = e->up[j];
+            e->size[e->column[j]]--;
+        }
+    }
+}
+
+static void uncover(solver_engine_t *e, uint16_t c) {
+    for (uint16_t i = e->up[c]; i != c; i = e->up[i]) {
+        for (uint16_t j = e->left[i]; j != i; j = e->left[j]) {
+            e->size[e->column[j]]++;
+            e->down[e->up[j]] = j;
+            e->up[e->down[j]] = j;
+        }
+    }
+    e->right[e->left[c]] = c;
+    e->left[e->right[c]] = c;
+    e->covered[c] = false;
+}
+
+static void select_row(solver_engine_t *e, uint16_t r) {
+    cover(e, e->column[r]);
+    for (uint16_t j = e->right[r]; j != r; j = e->right[j]) {
+        cover(e, e->column[j]);
+    }
+}
+
+static void unselect_row(solver_engine_t *e, uint16_t r) {
+    for (uint16_t j = e->left[r]; j != r; j = e->left[j]) {
+        uncover(e, e->column[j]);
+    }
+    uncover(e, e->column[r]);
+}
+
+static uint16_t choose_column(const solver_engine_t *e) {
+    uint16_t best = e->right[DLX_ROOT];
+    for (uint16_t c = e->right[best]; c != DLX_ROOT; c = e->right[c]) {
+        if (e->size[c] < e->size[best]) {
+            best = c;
+            if (e->size[c] <= 1) {
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+static void unload_givens(solver_engine_t *e) {
+    while (e->depth > 0) {
+        unselect_row(e, e->chosen[--e->depth]);
+    }
+}
+
+// Selects the givens of the puzzle as fixed rows. Returns false, with the
+// matrix restored, if two givens compete for the same column. Whatever an
+// abandoned search left selected is backed out first.
+static bool load_givens(solver_engine_t *e, const sudoku_puzzle_t *puzzle) {
+    unload_givens(e);
+    e->stack_len = 0;
+
+    for (int cell = 0; cell < 81; cell++) {
+        uint8_t num = puzzle->grid[cell];
+        if (num == 0) {
+            continue;
+        }
+
+        uint16_t r = row_node(row_id(cell, num));
+        uint16_t j = r;
+        do {
+            if (e->covered[e->column[j]]) {
+                unload_givens(e);
+                return false;
+            }
+        } while ((j = e->right[j]) != r);
+        select_row(e, r);
+        e->chosen[e->depth++] = r;
+    }
+
+    return true;
+}
+
+void solver_init(solver_ctx_t *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    rng_seed_entropy(&ctx->rng);
+    build_matrix(&ctx->engine);
+}
+
+// The frame's next row to try: the one below the current, or with shuffle
+// a random one of those not tried yet. Returns the column header once the
+// column is used up.
+static uint16_t next_row(solver_ctx_t *ctx, dlx_frame_t *f, bool shuffle) {
+    solver_engine_t *e = &ctx->engine;
+
+    if (!shuffle) {
+        return e->down[f->row];
+    }
+
+    int left = e->size[f->column] - __builtin_popcount(f->tried);
+    if (left == 0) {
+        return f->column;
+    }
+    uint32_t skip = rng_below(&ctx->rng, (uint32_t)left);
+    int i = 0;
+    for (uint16_t r = e->down[f->column]; r != f->column; r = e->down[r], i++) {
+        if (!(f->tried & (1U << i)) && skip-- == 0) {
+            f->tried |= (uint16_t)(1U << i);
+            return r;
+        }
+    }
+    return f->column;
+}
+
+// Backs out of the row selected in the innermost frame and selects its next
+// one, closing frames that have none left. Returns false once the whole
+// tree is done.
+static bool next_branch(solver_ctx_t *ctx, bool shuffle) {
+    solver_engine_t *e = &ctx->engine;
+
+    while (e->stack_len > 0) {
+        dlx_frame_t *f = &e->stack[e->stack_len - 1];
+        if (f->row != f->column) {
+            e->depth--;
+            unselect_row(e, f->row);
+        }
+
+        uint16_t r = next_row(ctx, f, shuffle);
+        if (r != f->column) {
+            select_row(e, r);
+            e->chosen[e->depth++] = r;
+            f->row = r;
+            return true;
+        }
+        e->stack_len--;
+    }
+    return false;
+}
+
+// Algorithm X over at most `budget` nodes, without recursion: each open
+// column is a frame on the engine's stack, so the search can stop between
+// any two nodes and carry on from there on the next call. Stops for good
+// after max_solutions solutions, writing the last one to puzzle if given,
+// or once the tree is exhausted.
+static search_t search(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle,
+                       uint32_t budget, bool shuffle) {
+    solver_engine_t *e = &ctx->engine;
+
+    for (; budget > 0; budget--) {
+        ctx->node_count++;
+        if (e->right[DLX_ROOT] == DLX_ROOT) {
+            if (++ctx->solution_count >= ctx->max_solutions) {
+                for (int i = 0; puzzle && i < e->depth; i++) {
+                    int id = node_row_id(e->chosen[i]);
+                    puzzle->grid[id / 9] = (uint8_t)(id % 9 + 1);
+                }
+                return SEARCH_FOUND;
+            }
+        } else {
+            uint16_t c = choose_column(e);
+            if (e->size[c] > 0) {
+                dlx_frame_t *f = &e->stack[e->stack_len++];
+                f->column = c;
+                f->row = c;
+                f->tried = 0;
+            }
+        }
+
+        if (!next_branch(ctx, shuffle)) {
+            return SEARCH_EXHAUSTED;
+        }
+    }
+    return SEARCH_BUSY;
+}
+
+bool solve_puzzle(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle) {
+    ctx->node_count = 0;
+    ctx->searching = false;
+    if (!load_givens(&ctx->engine, puzzle)) {
+        return false;
+    }
+
+    ctx->solution_count = 0;
+    ctx->max_solutions = 1;
+    bool solved = search(ctx, puzzle, UINT32_MAX, true) == SEARCH_FOUND;
+    unload_givens(&ctx->engine);
+    return solved;
+}
+
+void solver_unique_begin(solver_ctx_t *ctx, const sudoku_puzzle_t *puzzle) {
+    ctx->solution_count = 0;
+    ctx->max_solutions = 2;
+    ctx->node_count = 0;
+    ctx->searching = load_givens(&ctx->engine, puzzle);
+}
+
+bool solver_unique_step(solver_ctx_t *ctx, uint32_t budget) {
+    if (ctx->searching && search(ctx, NULL, budget, false) != SEARCH_BUSY) {
+        ctx->searching = false;
+        unload_givens(&ctx->engine);
+    }
+    return !ctx->searching;
+}
+
+#endif // SUDOKU_ENGINE == SUDOKU_ENGINE_DLX
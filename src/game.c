@@ -1,12 +1,15 @@
 #include "game.h"
 #include "audio.h"
+#include "code.h"
 #include "eeprom.h"
 #include "hub75.h"
 #include "font.h"
+#include "generator.h"
+#include "hint.h"
 #include "oled.h"
 #include "keypad.h"
 #include "joystick.h"
-#include "rng.h"
+#include "pool.h"
 #include "sudoku.h"
 #include "pico/stdlib.h"
 #include <stdio.h>
@@ -15,7 +18,7 @@
 #include <stdlib.h>
 
 static void draw_sudoku_puzzle(sudoku_puzzle_t *puzzle);
-static void draw_sudoku_cell(uint8_t row, uint8_t col, color_t color);
+static void draw_sudoku_cell(uint8_t row, uint8_t col, uint8_t index);
 static void draw_cursor_ring(float row, float col);
 
 static void draw_intro_screen();
@@ -23,13 +26,21 @@ static void draw_help_screen();
 static void draw_color_rush_animation(uint32_t time_ms);
 
 static void get_cell_position(uint8_t row, uint8_t col, uint8_t *x, uint8_t *y);
-static color_t number_to_color(uint8_t num);
 
-static void create_puzzle_from_solution(sudoku_puzzle_t *puzzle, int cells_to_remove);
-static unsigned cells_to_remove_by_difficulty(difficulty_t difficulty);
+static void game_start_puzzle(const solve_path_t *path);
+static bool game_play_code(uint32_t code);
+static void game_return_to_menu();
+static void game_update_code_entry();
+static void game_update_generating();
+static void game_set_cell(uint8_t row, uint8_t col, uint8_t value);
 static void game_give_hint();
 
 static game_state_t game_state;
+static hint_t hints;
+static solver_ctx_t solver;
+static generator_t generator;
+// Shared by the game's and the pool's generators and run on core1.
+static generator_probe_t probe;
 static game_screen_state_t current_screen_state = GAME_STATE_INTRO;
 static difficulty_t selected_difficulty;
 
@@ -46,7 +57,21 @@ static const float lerp_speed = .2f;
 static const float snap_threshold = .05f;
 static unsigned blink_start_time = 0;
 
-static unsigned randn = 0;
+static bool did_show_level = false;
+
+static char code_text[PUZZLE_CODE_DIGITS + 1];
+static unsigned code_length = 0;
+static bool did_show_code = false;
+
+// The board screens draw in indexed mode: palette entry 0 is black and 1-9
+// are the digits' colours from color_map, so a cell's value is its index.
+// The cursor has an entry of its own.
+#define PALETTE_CURSOR 10
+
+// Pool refills only run once the player has been idle this long, so a
+// puzzle being generated never stalls input that is actively happening.
+#define POOL_IDLE_MS 500
+static uint32_t last_input_time_ms = 0;
 
 void game_init() {
     memset(&game_state, 0, sizeof(game_state_t));
@@ -56,7 +81,22 @@ void game_init() {
     intro_animation_done = false;
     intro_text_shown = false;
 
-    randn = rand() % 81;
+    for (uint8_t digit = 1; digit <= 9; digit++) {
+        hub75_set_palette(digit, color_map[digit - 1].r, color_map[digit - 1].g,
+                          color_map[digit - 1].b);
+    }
+    hub75_set_palette(PALETTE_CURSOR, COLOR_WHITE);
+
+    solver_init(&solver);
+    generator_probe_init(&probe);
+    generator_attach(&generator, &probe);
+
+    puzzle_pool_init(&probe);
+    generator_cancel(&generator);
+}
+
+bool game_idle() {
+    return generator_probe_run(&probe, GENERATOR_PROBE_NODES);
 }
 
 void game_update() {
@@ -82,9 +122,15 @@ void game_update() {
                     selected_difficulty = DIFFICULTY_HARD;
                 }
 
+                if (key == '#' && intro_animation_done) {
+                    code_length = 0;
+                    did_show_code = false;
+                    oled_clear(OLED_DISPLAY2);
+                    current_screen_state = GAME_STATE_CODE_ENTRY;
+                    break;
+                }
+
                 if (key == '1' || key == '2' || key == '3') {
-                    current_screen_state = GAME_STATE_PLAYING;
-                    lock_refresh();
                     game_new_puzzle(selected_difficulty);
                     intro_animation_time = 0;
                     intro_animation_done = false;
@@ -92,12 +138,31 @@ void game_update() {
                     oled_clear(OLED_DISPLAY1);
                     oled_clear(OLED_DISPLAY2);
                     hub75_clear();
-                    unlock_refresh();
                     break;
                 }
             }
         }
 
+        if (current_screen_state == GAME_STATE_MENU ||
+            (current_screen_state == GAME_STATE_INTRO && intro_animation_done)) {
+            puzzle_pool_refill(GENERATOR_SLICE_NODES);
+        }
+
+        return;
+    }
+
+    if (current_screen_state == GAME_STATE_CODE_ENTRY) {
+        game_update_code_entry();
+        return;
+    }
+
+    if (current_screen_state == GAME_STATE_GENERATING) {
+        game_update_generating();
+        return;
+    }
+
+    if (current_screen_state == GAME_STATE_PAUSED) {
+        puzzle_pool_refill(GENERATOR_SLICE_NODES);
         return;
     }
 
@@ -115,13 +180,14 @@ void game_update() {
             oled_display_at(OLED_DISPLAY1, 0, 1, buffer);
         }
         
-        static bool did_show_difficulty = false;
-        if (!did_show_difficulty) {
+        if (!did_show_level) {
+            char code[PUZZLE_CODE_DIGITS + 1];
             char buffer[16];
-            snprintf(buffer, (sizeof buffer), "Level: %s", DIFFICULTY_NAMES[game_state.difficulty]);
+            puzzle_code_format(game_state.code, code);
+            snprintf(buffer, (sizeof buffer), "%-5s%s", DIFFICULTY_NAMES[game_state.difficulty], code);
             buffer[15] = '\0';
             oled_display_at(OLED_DISPLAY1, 1, 1, buffer);
-            did_show_difficulty = true;
+            did_show_level = true;
         }
 
         static bool did_show_options = false;
@@ -175,23 +241,66 @@ void game_update() {
         }
 
         audio_update();
+
+        if (time_us_32() / 1000 - last_input_time_ms >= POOL_IDLE_MS) {
+            puzzle_pool_refill(GENERATOR_SLICE_NODES);
+        }
     }
 }
 
+// Takes a ready puzzle from the pool if there is one, otherwise starts
+// generating it a slice at a time on the generating screen.
 void game_new_puzzle(difficulty_t difficulty) {
     game_state.difficulty = difficulty;
+
+    solve_path_t path;
+    if (puzzle_pool_pop(difficulty, &game_state.puzzle, &game_state.code,
+                        &path)) {
+        generator_cancel(&generator);
+        game_start_puzzle(&path);
+        return;
+    }
+
+    generator_start(&generator, &solver, difficulty);
+    current_screen_state = GAME_STATE_GENERATING;
+}
+
+// Starts the puzzle behind a code: straight from the cache if it was
+// played recently, otherwise regenerated from its seed. Returns false for
+// a code this build cannot make.
+static bool game_play_code(uint32_t code) {
+    uint32_t seed;
+    difficulty_t difficulty;
+    if (!puzzle_code_parse(code, &seed, &difficulty)) {
+        return false;
+    }
+
+    game_state.difficulty = difficulty;
+    game_state.code = code;
+    if (puzzle_cache_get(code, &game_state.puzzle)) {
+        generator_cancel(&generator);
+        game_start_puzzle(NULL);
+        return true;
+    }
+
+    generator_start_seed(&generator, &solver, difficulty, seed);
+    current_screen_state = GAME_STATE_GENERATING;
+    return true;
+}
+
+// path is the puzzle's logical solve path, or NULL to have it solved again.
+static void game_start_puzzle(const solve_path_t *path) {
+    puzzle_cache_put(game_state.code, &game_state.puzzle);
+    conflict_index_init(&game_state.conflicts, &game_state.puzzle);
+    hint_init(&hints, &game_state.puzzle, path);
+    did_show_level = false;
+
     game_state.cursor_row = game_state.cursor_col = 4;
     cursor_x = cursor_y = 4.0f;
     game_state.selected_color = 0;
     game_state.solved = false;
     blink_start_time = time_us_32() / 1000000;
 
-    const int cells_to_remove = cells_to_remove_by_difficulty(difficulty);
-
-    clear(&game_state.puzzle);
-    solve_puzzle(&game_state.puzzle);
-    create_puzzle_from_solution(&game_state.puzzle, cells_to_remove);
-
     game_state.start_time = time_us_32() / 1000000;
     game_state.elapsed_time = 0;
 
@@ -201,8 +310,128 @@ void game_new_puzzle(difficulty_t difficulty) {
     } else {
         game_state.best_time = 5999;
     }
+
+    current_screen_state = GAME_STATE_PLAYING;
 }
 
+// Runs one generator slice per frame and shows the carving as it happens.
+// '*' cancels back to the menu and a difficulty key restarts generation;
+// the board in game_state is only replaced once a puzzle is complete.
+static void game_update_generating() {
+    static bool did_show_generating = false;
+
+    while (1) {
+        uint16_t event = keypad_get_event();
+        if (event == 0) {
+            break;
+        }
+        if (!keypad_is_pressed(event)) {
+            continue;
+        }
+
+        char key = keypad_get_char(event);
+        if (key == '*') {
+            generator_cancel(&generator);
+            game_return_to_menu();
+            did_show_generating = false;
+            return;
+        }
+        if (key >= '1' && key <= '3') {
+            selected_difficulty = (difficulty_t)(DIFFICULTY_EASY + (key - '1'));
+            game_state.difficulty = selected_difficulty;
+            generator_start(&generator, &solver, selected_difficulty);
+        }
+    }
+
+    if (!did_show_generating) {
+        oled_display_at(OLED_DISPLAY2, 0, 0, "Generating...");
+        oled_display_at(OLED_DISPLAY2, 1, 0, " *=Cancel       ");
+        did_show_generating = true;
+    }
+
+    generator_step(&generator, GENERATOR_SLICE_NODES);
+
+    hub75_set_indexed(true);
+    hub75_clear();
+    draw_sudoku_puzzle(&generator.puzzle);
+
+    audio_update();
+
+    if (generator.phase == GENERATOR_DONE) {
+        memcpy(&game_state.puzzle, &generator.puzzle, sizeof(sudoku_puzzle_t));
+        game_state.code = puzzle_code_make(generator.seed, generator.difficulty);
+        generator_cancel(&generator);
+        did_show_generating = false;
+        oled_clear(OLED_DISPLAY2);
+        hub75_clear();
+        game_start_puzzle(&generator.path);
+    }
+}
+
+static void game_return_to_menu() {
+    hub75_clear();
+    oled_clear(OLED_DISPLAY2);
+    oled_display_at(OLED_DISPLAY2, 0, 0, "Pick Difficulty");
+    oled_display_at(OLED_DISPLAY2, 1, 0, "1E 2M 3H #=Code");
+    // Skip straight past the intro animation back to the menu
+    intro_animation_time = time_us_32() / 1000 - 2000;
+    current_screen_state = GAME_STATE_MENU;
+}
+
+// Typing in a puzzle code from the menu: digits append, '*' deletes the
+// last one or leaves when there are none, '#' plays the code.
+static void game_update_code_entry() {
+    bool changed = false;
+    bool rejected = false;
+
+    while (1) {
+        uint16_t event = keypad_get_event();
+        if (event == 0) {
+            break;
+        }
+        if (!keypad_is_pressed(event)) {
+            continue;
+        }
+
+        char key = keypad_get_char(event);
+        if (key >= '0' && key <= '9' && code_length < PUZZLE_CODE_DIGITS) {
+            code_text[code_length++] = key;
+            changed = true;
+        } else if (key == '*') {
+            if (code_length == 0) {
+                game_return_to_menu();
+                return;
+            }
+            code_length--;
+            changed = true;
+        } else if (key == '#') {
+            uint32_t code = 0;
+            for (unsigned i = 0; i < code_length; i++) {
+                code = code * 10 + (uint32_t)(code_text[i] - '0');
+            }
+            if (code_length == PUZZLE_CODE_DIGITS && game_play_code(code)) {
+                intro_animation_time = 0;
+                intro_animation_done = false;
+                intro_text_shown = false;
+                oled_clear(OLED_DISPLAY1);
+                oled_clear(OLED_DISPLAY2);
+                hub75_clear();
+                return;
+            }
+            rejected = true;
+        }
+    }
+    code_text[code_length] = '\0';
+
+    if (changed || rejected || !did_show_code) {
+        char buffer[17];
+        snprintf(buffer, (sizeof buffer), "Code: %-9s ", code_text);
+        oled_display_at(OLED_DISPLAY2, 0, 0, buffer);
+        oled_display_at(OLED_DISPLAY2, 1, 0,
+                        rejected ? " Bad code       " : " #=Play  *=Del  ");
+        did_show_code = true;
+    }
+}
 
 void game_handle_keypad() {
     show_help = keypad_is_key_held('*');
@@ -216,13 +445,11 @@ void game_handle_keypad() {
 
         if (keypad_is_pressed(keypad_event)) {
             char key = keypad_get_char(keypad_event);
+            last_input_time_ms = time_us_32() / 1000;
 
             switch (key) {
             case '0':
-                set(&game_state.puzzle,
-                    game_state.cursor_row,
-                    game_state.cursor_col,
-                    0);
+                game_set_cell(game_state.cursor_row, game_state.cursor_col, 0);
                 break;
 
             case '1':
@@ -235,10 +462,8 @@ void game_handle_keypad() {
             case '8':
             case '9':
                 game_state.selected_color = key - '1';
-                set(&game_state.puzzle,
-                    game_state.cursor_row,
-                    game_state.cursor_col,
-                    game_state.selected_color + 1);
+                game_set_cell(game_state.cursor_row, game_state.cursor_col,
+                              game_state.selected_color + 1);
                 break;
 
             case '#':
@@ -278,29 +503,37 @@ void game_handle_joystick() {
     }
 
     if (direction != DIRECTION_NONE) {
+        last_input_time_ms = time_us_32() / 1000;
         hub75_clear();
         audio_play_blip();
     }
 }
 
 bool game_check_solved() {
-    for (unsigned i = 0; i < 81; ++i) {
-        if (game_state.puzzle.grid[i] == 0) {
-            return false;
-        }
-    }
-    return is_valid(&game_state.puzzle);
+    return conflict_index_solved(&game_state.conflicts);
 }
 
 void game_draw_board() {
     if (show_help) {
+        hub75_set_indexed(false);
         draw_help_screen();
         //hub75_refresh();
         return;
     }
 
+    hub75_set_indexed(true);
     draw_sudoku_puzzle(&game_state.puzzle);
 
+    // Digits that clash with a peer blink at 2 Hz.
+    if (!conflict_index_clean(&game_state.conflicts) &&
+        (time_us_32() / 250000) % 2 == 1) {
+        for (int cell = 0; cell < 81; cell++) {
+            if (conflict_index_cell(&game_state.conflicts, &game_state.puzzle, cell)) {
+                draw_sudoku_cell(cell / 9, cell % 9, 0);
+            }
+        }
+    }
+
     uint32_t current_time = time_us_32() / 1000000;
     uint32_t time_since_move = current_time - blink_start_time;
     bool show_cursor = cursor_moving || ((time_since_move % 2) == 0);
@@ -315,24 +548,18 @@ void game_draw_board() {
 static void draw_sudoku_puzzle(sudoku_puzzle_t *puzzle) {
     for (uint8_t row = 0; row < 9; row++) {
         for (uint8_t col = 0; col < 9; col++) {
-            uint8_t value = get(puzzle, row, col);
-            color_t color = number_to_color(value);
-            draw_sudoku_cell(row, col, color);
+            draw_sudoku_cell(row, col, get(puzzle, row, col));
         }
     }
 }
 
-static void draw_sudoku_cell(uint8_t row, uint8_t col, color_t color) {
+static void draw_sudoku_cell(uint8_t row, uint8_t col, uint8_t index) {
     uint8_t start_x, start_y;
     get_cell_position(row, col, &start_x, &start_y);
 
     for (uint8_t dy = 0; dy < 2; ++dy) {
         for (uint8_t dx = 0; dx < 2; ++dx) {
-            hub75_set_pixel(start_x + dx,
-                            start_y + dy,
-                            color.r,
-                            color.g,
-                            color.b);
+            hub75_set_index(start_x + dx, start_y + dy, index);
         }
     }
 }
@@ -346,24 +573,24 @@ static void draw_cursor_ring(float row, float col) {
 
     for (int16_t x = start_x - 1; x <= start_x + 2; x++) {
         if (x >= 0 && x < HUB75_PANEL_WIDTH && start_y - 1 >= 0) {
-            hub75_set_pixel(x, start_y - 1, 255, 255, 255);
+            hub75_set_index(x, start_y - 1, PALETTE_CURSOR);
         }
     }
     for (int16_t x = start_x - 1; x <= start_x + 2; x++) {
         if (x >= 0 && x < HUB75_PANEL_WIDTH &&
             start_y + 2 < HUB75_PANEL_HEIGHT) {
-            hub75_set_pixel(x, start_y + 2, 255, 255, 255);
+            hub75_set_index(x, start_y + 2, PALETTE_CURSOR);
         }
     }
     for (int16_t y = start_y; y <= start_y + 1; y++) {
         if (start_x - 1 >= 0 && y >= 0 && y < HUB75_PANEL_HEIGHT) {
-            hub75_set_pixel(start_x - 1, y, 255, 255, 255);
+            hub75_set_index(start_x - 1, y, PALETTE_CURSOR);
         }
     }
     for (int16_t y = start_y; y <= start_y + 1; y++) {
         if (start_x + 2 < HUB75_PANEL_WIDTH && y >= 0 &&
             y < HUB75_PANEL_HEIGHT) {
-            hub75_set_pixel(start_x + 2, y, 255, 255, 255);
+            hub75_set_index(start_x + 2, y, PALETTE_CURSOR);
         }
     }
 }
@@ -371,6 +598,8 @@ static void draw_cursor_ring(float row, float col) {
 static void draw_intro_screen() {
     uint32_t current_time_ms = time_us_32() / 1000;
 
+    hub75_set_indexed(false);
+
     if (intro_animation_time == 0) {
         intro_animation_time = current_time_ms;
     }
@@ -379,9 +608,7 @@ static void draw_intro_screen() {
 
     // Phase 1: Color rush animation
     if (elapsed < 2000) {
-        //lock_refresh();
         draw_color_rush_animation(elapsed);
-        hub75_refresh();
 
         static bool did_show_welcome = false;
         if (!did_show_welcome) {
@@ -394,7 +621,6 @@ static void draw_intro_screen() {
         return;
     }
 
-    unlock_refresh();
     {
         static bool did_clear = false;
         if (!did_clear) {
@@ -416,7 +642,7 @@ static void draw_intro_screen() {
     if (!did_show_difficulty) {
         oled_clear(OLED_DISPLAY2);
         oled_display_at(OLED_DISPLAY2, 0, 0, "Pick Difficulty");
-        oled_display_at(OLED_DISPLAY2, 1, 0, " 1=E  2=M  3=H ");
+        oled_display_at(OLED_DISPLAY2, 1, 0, "1E 2M 3H #=Code");
         did_show_difficulty = true;
     }
 
@@ -499,74 +725,30 @@ static void get_cell_position(uint8_t row, uint8_t col, uint8_t *x, uint8_t *y)
     *y = 2 + (row / 3) + (row * 3);
 }
 
-static color_t number_to_color(uint8_t num) {
-    if (num == 0 || num > 9) {
-        color_t black = {0, 0, 0};
-        return black;
-    }
-    color_t color;
-    color.r = color_map[num - 1].r;
-    color.g = color_map[num - 1].g;
-    color.b = color_map[num - 1].b;
-    return color;
+// Every edit to the board goes through here, so the conflict index and the
+// hint path stay in step with it.
+static void game_set_cell(uint8_t row, uint8_t col, uint8_t value) {
+    conflict_index_set(&game_state.conflicts, &game_state.puzzle, row, col,
+                       value);
+    hint_update(&hints, &game_state.puzzle, row * 9 + col);
 }
 
-static void create_puzzle_from_solution(sudoku_puzzle_t *puzzle,
-                                        int cells_to_remove) {
-    memcpy(puzzle->solution, puzzle->grid, 81);
-
-    uint8_t positions[81];
-    for (int i = 0; i < 81; i++) {
-        positions[i] = i;
+// Fills in the next cell of the solve path, the one the player could have
+// deduced from the board as it stands, and names the technique it takes.
+static void game_give_hint() {
+    technique_t technique;
+    const int cell = hint_next(&hints, &game_state.puzzle, &technique);
+    if (cell < 0) {
+        return;
     }
-    shuffle_array(positions, 81);
-
-    //hub75_clear();
-
-    int removed = 0;
-    for (int i = 0; i < 81 && removed < cells_to_remove; i++) {
-        sleep_ms(10);
-        int pos = positions[i];
-        int row = pos / 9;
-        int col = pos % 9;
-
-        uint8_t backup = get(puzzle, row, col);
-        set(puzzle, row, col, 0);
-
-        if (has_unique_solution(puzzle)) {
-            removed++;
-        } else {
-            set(puzzle, row, col, backup);
-        }
+    game_set_cell(cell / 9, cell % 9, game_state.puzzle.solution[cell]);
 
-        // Show progressive carving on panel
-        draw_sudoku_puzzle(puzzle);
-        //hub75_refresh();
-    }
-}
+    game_state.cursor_col = cell % 9;
+    game_state.cursor_row = cell / 9;
 
-static unsigned cells_to_remove_by_difficulty(difficulty_t difficulty) {
-    switch (difficulty) {
-    case DIFFICULTY_EASY:
-        return 36;
-    case DIFFICULTY_MEDIUM:
-        return 42;
-    case DIFFICULTY_HARD:
-        return 50;
-    default:
-        return cells_to_remove_by_difficulty(DIFFICULTY_DEFAULT);
-    }
-}
+    char buffer[17];
+    snprintf(buffer, (sizeof buffer), "%-16s", grader_technique_name(technique));
+    oled_display_at(OLED_DISPLAY2, 0, 0, buffer);
 
-static void game_give_hint() {
-    while (game_state.puzzle.grid[randn] != 0) {
-        randn = (randn + 31) % 81;
-    }
-    game_state.puzzle.grid[randn] = game_state.puzzle.solution[randn];
-    
-    game_state.cursor_col = randn % 9;
-    game_state.cursor_row = randn / 9;
-    
     blink_start_time = time_us_32() / 1000000;
-    randn = (randn + 1) % 81;
 }
@@ -0,0 +1,378 @@
+#include "generator.h"
+#include "grader.h"
+#include "kernel.h"
+#include "rng.h"
+#include <string.h>
+
+// The probe's ticket counters are shared with the other core.
+static inline uint32_t ticket_load(const uint32_t *ticket) {
+    return __atomic_load_n(ticket, __ATOMIC_ACQUIRE);
+}
+
+static inline void ticket_store(uint32_t *ticket, uint32_t value) {
+    __atomic_store_n(ticket, value, __ATOMIC_RELEASE);
+}
+
+void generator_probe_init(generator_probe_t *probe) {
+    solver_init(&probe->solver);
+    probe->running = false;
+    probe->posted = probe->finished = probe->cancelled = 0;
+    probe->owner = NULL;
+}
+
+bool generator_probe_run(generator_probe_t *probe, uint32_t budget) {
+    const uint32_t ticket = ticket_load(&probe->posted);
+    if (ticket == probe->finished) {
+        return false;
+    }
+
+    if (ticket_load(&probe->cancelled) == ticket) {
+        probe->running = false;
+        ticket_store(&probe->finished, ticket);
+        return true;
+    }
+    if (!probe->running) {
+        solver_unique_begin(&probe->solver, &probe->puzzle);
+        probe->running = true;
+    }
+    if (solver_unique_step(&probe->solver, budget)) {
+        probe->unique = solver_unique_result(&probe->solver);
+        probe->running = false;
+        ticket_store(&probe->finished, ticket);
+    }
+    return true;
+}
+
+#define CARVE_NONE 0xFFU
+
+_Static_assert(GENERATOR_WINDOW >= 1 && GENERATOR_WINDOW <= 8,
+               "carve tests keep their guesses in 8 bits");
+
+static inline carve_test_t *test_at(generator_t *gen, uint8_t index) {
+    return &gen->tests[index % GENERATOR_WINDOW];
+}
+
+// Forgets every test still running and starts again from the oldest
+// undecided cell.
+static void drop_tests(generator_t *gen) {
+    if (gen->probe && gen->remote != CARVE_NONE && gen->probe->owner == gen) {
+        ticket_store(&gen->probe->cancelled, gen->ticket);
+    }
+    gen->local = CARVE_NONE;
+    gen->remote = CARVE_NONE;
+    gen->next = gen->settled;
+}
+
+void generator_attach(generator_t *gen, generator_probe_t *probe) {
+    drop_tests(gen);
+    gen->probe = probe;
+}
+
+void generator_start_seed(generator_t *gen, solver_ctx_t *solver,
+                          difficulty_t difficulty, uint32_t seed) {
+    // Everything random below comes from this one stream, and slicing
+    // never changes the order of draws, so the result depends on nothing
+    // else.
+    gen->seed = seed & (GENERATOR_SEEDS - 1);
+    solver_seed_stream(solver, gen->seed, (uint32_t)difficulty);
+
+    gen->solver = solver;
+    gen->difficulty = difficulty;
+    gen->min = grader_tier_min(difficulty);
+    gen->max = grader_tier_max(difficulty);
+    drop_tests(gen);
+    gen->phase = GENERATOR_FILLING;
+    gen->nodes = 0;
+    clear(&gen->puzzle);
+}
+
+// The seed comes from entropy rather than the solver's stream: that stream
+// was itself seeded by the last puzzle, so two solvers that once made the
+// same puzzle would otherwise go on making the same ones.
+void generator_start(generator_t *gen, solver_ctx_t *solver, difficulty_t difficulty) {
+    generator_start_seed(gen, solver, difficulty, rng_entropy());
+}
+
+void generator_cancel(generator_t *gen) {
+    drop_tests(gen);
+    gen->phase = GENERATOR_IDLE;
+}
+
+// Starts carving the full solution in a new random order.
+static void start_carve(generator_t *gen) {
+    memcpy(gen->puzzle.grid, gen->puzzle.solution, 81);
+    for (int i = 0; i < 81; i++) {
+        gen->positions[i] = i;
+    }
+    rng_shuffle(&gen->solver->rng, gen->positions, 81);
+
+    drop_tests(gen);
+    gen->next = 0;
+    gen->settled = 0;
+    gen->removed = 0;
+    gen->carves++;
+    // Early removals from a full board are all kept.
+    gen->history = 0xFF;
+    gen->phase = GENERATOR_CARVING;
+}
+
+static uint32_t fill_step(generator_t *gen) {
+    solver_ctx_t *ctx = gen->solver;
+
+    clear(&gen->puzzle);
+    solve_puzzle(ctx, &gen->puzzle);
+    memcpy(gen->puzzle.solution, gen->puzzle.grid, 81);
+
+    gen->carves = 0;
+    start_carve(gen);
+    gen->nodes += solver_node_count(ctx);
+    return solver_node_count(ctx);
+}
+
+// Once every cell has been tried the puzzle is as sparse as its tier
+// allows. If it still does not need the tier's easiest technique, carve the
+// same solution again in another order; the solution is rarely to blame,
+// but after GENERATOR_MAX_CARVES misses a new one is filled.
+static uint32_t finish_step(generator_t *gen) {
+    grader_solve_path(&gen->puzzle, &gen->grade, &gen->path);
+    if (gen->grade.hardest >= gen->min) {
+        gen->phase = GENERATOR_DONE;
+    } else if (gen->carves < GENERATOR_MAX_CARVES) {
+        start_carve(gen);
+    } else {
+        gen->phase = GENERATOR_FILLING;
+    }
+    return gen->grade.steps;
+}
+
+// Runs naked and hidden singles over the puzzle, in place, and returns
+// whether they solve it. The kernel answers that far faster than a full
+// grade, but only knows the classic units, so under variant rules a miss
+// still goes to the grader.
+static bool reduce_singles(sudoku_puzzle_t *puzzle) {
+    int row, col;
+    return kernel_reduce(puzzle) && !find_empty_cell(puzzle, &row, &col);
+}
+
+// Applies the decision on the oldest undecided cell.
+static void decide(generator_t *gen, bool keep) {
+    if (keep) {
+        gen->puzzle.grid[gen->positions[gen->settled]] = 0;
+        gen->removed++;
+    }
+    gen->history = (uint8_t)(gen->history << 1 | keep);
+    gen->settled++;
+}
+
+// Below the guessing tier the grader alone decides: a puzzle it solves
+// logically has a unique solution, and one that needs a harder technique
+// than the tier allows is rejected either way. Most removals that get past
+// singles leave several solutions though, and the solver finds those far
+// sooner than the grader runs out of techniques, so it gets the first
+// look. Returns the work spent, in solver nodes and grader steps.
+static uint32_t carve_logical(generator_t *gen) {
+    // Both pick up where singles got stuck, which gives the same answers as
+    // starting from the puzzle itself.
+    sudoku_puzzle_t reduced = gen->puzzle;
+    reduced.grid[gen->positions[gen->settled]] = 0;
+    bool keep = reduce_singles(&reduced);
+    uint32_t cost = 1;
+    if (!keep && (gen->max > TECHNIQUE_NAKED_SINGLE || !UNITS_CLASSIC)) {
+        sudoku_puzzle_t board = reduced;
+        keep = has_unique_solution(gen->solver, &board);
+        gen->nodes += solver_node_count(gen->solver);
+        cost += solver_node_count(gen->solver);
+        if (keep) {
+            grade_t grade;
+            keep = grader_grade_within(&reduced, gen->max, &grade);
+            cost += grade.steps;
+        }
+    }
+
+    decide(gen, keep);
+    gen->next = gen->settled;
+    return cost;
+}
+
+// Picks the next cell to test: the oldest undecided one if it has to run
+// again, otherwise a new one while the window has room. Cells before it
+// that are still undecided are guessed to go the way their finished test
+// says. Failing that they are guessed removed only while every recent
+// removal was kept: once carving starts failing, most later removals fail
+// too, and a wrong guess of a kept cell costs less (see settle()). `board`
+// is set to the settled board with the cell and the guessed removals taken
+// out. Returns CARVE_NONE if there is nothing to test.
+static uint8_t take_test(generator_t *gen, sudoku_puzzle_t *board) {
+    uint8_t index;
+    if (gen->settled < gen->next &&
+        test_at(gen, gen->settled)->state == CARVE_TEST_RETRY) {
+        index = gen->settled;
+    } else if (gen->next < 81 && gen->next - gen->settled < GENERATOR_WINDOW) {
+        index = gen->next++;
+    } else {
+        return CARVE_NONE;
+    }
+
+    carve_test_t *test = test_at(gen, index);
+    test->state = CARVE_TEST_RUNNING;
+    test->depth = index - gen->settled;
+    test->assumed = 0;
+
+    *board = gen->puzzle;
+    board->grid[gen->positions[index]] = 0;
+    for (uint8_t i = gen->settled; i < index; i++) {
+        const carve_test_t *before = test_at(gen, i);
+        bool keep = before->state == CARVE_TEST_DONE ? before->unique
+                                                     : gen->history == 0xFF;
+        if (keep) {
+            test->assumed |= (uint8_t)(1U << (index - 1 - i));
+            board->grid[gen->positions[i]] = 0;
+        }
+    }
+    return index;
+}
+
+static uint32_t run_local(generator_t *gen, uint32_t budget) {
+    uint32_t before = solver_node_count(gen->solver);
+    if (solver_unique_step(gen->solver, budget)) {
+        carve_test_t *test = test_at(gen, gen->local);
+        test->unique = solver_unique_result(gen->solver);
+        test->state = CARVE_TEST_DONE;
+        gen->local = CARVE_NONE;
+    }
+    const uint32_t spent = solver_node_count(gen->solver) - before;
+    gen->nodes += spent;
+    return spent;
+}
+
+// Posts the next cell to test to the probe, taking the probe over from
+// whichever generator used it last. Does nothing while the probe is still
+// winding down an earlier test.
+static void post_remote(generator_t *gen) {
+    generator_probe_t *probe = gen->probe;
+    if (probe->owner != gen) {
+        ticket_store(&probe->cancelled, probe->posted);
+        probe->owner = gen;
+    }
+    if (ticket_load(&probe->finished) != probe->posted) {
+        return;
+    }
+
+    gen->remote = take_test(gen, &probe->puzzle);
+    if (gen->remote != CARVE_NONE) {
+        gen->ticket = probe->posted + 1;
+        ticket_store(&probe->posted, gen->ticket);
+    }
+}
+
+// Collects the probe's result once it is in. A test lost to another
+// generator is run again.
+static void poll_remote(generator_t *gen) {
+    generator_probe_t *probe = gen->probe;
+    if (gen->remote == CARVE_NONE) {
+        return;
+    }
+
+    carve_test_t *test = test_at(gen, gen->remote);
+    if (probe->owner != gen) {
+        test->state = CARVE_TEST_RETRY;
+        gen->remote = CARVE_NONE;
+    } else if (ticket_load(&probe->finished) == gen->ticket) {
+        test->unique = probe->unique;
+        test->state = CARVE_TEST_DONE;
+        gen->remote = CARVE_NONE;
+    }
+}
+
+// Decides the oldest undecided cell once its test is in. A test whose
+// guesses were wrong may still decide: removing a cell never makes an
+// ambiguous puzzle unique, so a board with extra cells removed that is
+// still unique, or one with extra cells kept that is still ambiguous,
+// gives the answer anyway. Otherwise the test is marked to run again.
+// Returns whether a cell was decided.
+static bool settle(generator_t *gen) {
+    if (gen->settled >= gen->next) {
+        return false;
+    }
+    carve_test_t *test = test_at(gen, gen->settled);
+    if (test->state != CARVE_TEST_DONE) {
+        return false;
+    }
+
+    const uint8_t mask = (uint8_t)((1U << test->depth) - 1);
+    const uint8_t holes = test->assumed & ~gen->history & mask;
+    const uint8_t givens = ~test->assumed & gen->history & mask;
+    if ((holes && givens) || (holes && !test->unique) || (givens && test->unique)) {
+        test->state = CARVE_TEST_RETRY;
+        return false;
+    }
+
+    test->state = CARVE_TEST_IDLE;
+    decide(gen, test->unique);
+    return true;
+}
+
+// Tries to remove one more cell. Above the guessing tier the solver
+// decides, in slices of at most `budget` nodes, so one hard uniqueness
+// check can span several calls; with a probe attached, later cells are
+// tested on the other core meanwhile. Returns the work spent, in solver
+// nodes or grader steps, or the whole budget when waiting on the probe.
+static uint32_t carve_step(generator_t *gen, uint32_t budget) {
+    if (gen->max < TECHNIQUE_GUESS) {
+        return gen->settled < 81 ? carve_logical(gen) : finish_step(gen);
+    }
+
+    uint32_t cost = 0;
+    if (gen->probe) {
+        poll_remote(gen);
+    }
+    while (settle(gen)) {
+        cost++;
+    }
+    if (gen->settled >= 81) {
+        return cost + finish_step(gen);
+    }
+
+    if (gen->local == CARVE_NONE) {
+        sudoku_puzzle_t board;
+        gen->local = take_test(gen, &board);
+        if (gen->local != CARVE_NONE) {
+            solver_unique_begin(gen->solver, &board);
+        }
+    }
+    if (gen->probe && gen->remote == CARVE_NONE) {
+        post_remote(gen);
+    }
+    if (gen->local != CARVE_NONE) {
+        return cost + run_local(gen, budget);
+    }
+    return cost > 0 ? cost : budget;
+}
+
+generator_phase_t generator_step(generator_t *gen, uint32_t budget) {
+    uint32_t spent = 0;
+
+    do {
+        switch (gen->phase) {
+        case GENERATOR_FILLING:
+            spent += fill_step(gen);
+            break;
+        case GENERATOR_CARVING:
+            spent += carve_step(gen, budget > spent ? budget - spent : 1);
+            break;
+        default:
+            return gen->phase;
+        }
+    } while (spent < budget);
+
+    return gen->phase;
+}
+
+void generator_create_puzzle(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle,
+                             difficulty_t difficulty, uint32_t seed) {
+    generator_t gen = {.probe = NULL};
+    generator_start_seed(&gen, ctx, difficulty, seed);
+    while (generator_step(&gen, UINT32_MAX) != GENERATOR_DONE) {
+    }
+    memcpy(puzzle, &gen.puzzle, sizeof(sudoku_puzzle_t));
+}
@@ -0,0 +1,492 @@
+#include "grader.h"
+#include <string.h>
+
+// Logical solver used to grade puzzles. All bookkeeping is 9-bit digit
+// masks per cell, as in the backtracking solver, so one pass of any
+// technique is a few hundred mask operations.
+#define ALL_CANDIDATES 0x1FFU
+
+typedef struct {
+    uint8_t grid[81];
+    // Candidates of each empty cell; zero once the cell is filled.
+    uint16_t cand[81];
+    uint8_t empty;
+    // Placements are recorded here when set, tagged with the hardest of
+    // technique and since (eliminations since the last placement).
+    solve_path_t *path;
+    technique_t technique;
+    technique_t since;
+    uint8_t step;
+} grader_state_t;
+
+static void place(grader_state_t *s, int cell, uint8_t num) {
+    uint16_t bit = 1U << (num - 1);
+
+    if (s->path) {
+        path_step_t *p = &s->path->steps[s->path->length++];
+        p->cell = (uint8_t)cell;
+        p->technique = (uint8_t)(s->technique > s->since ? s->technique : s->since);
+        p->step = s->step;
+        s->since = TECHNIQUE_HIDDEN_SINGLE;
+    }
+
+    s->grid[cell] = num;
+    s->cand[cell] = 0;
+    s->empty--;
+    for (int i = 0; i < CELL_PEERS; i++) {
+        s->cand[cell_peers[cell][i]] &= ~bit;
+    }
+#if !UNITS_CLASSIC
+    CELLSET_FOR_EACH(peer, cell_variant_peers[cell]) {
+        s->cand[peer] &= ~bit;
+    }
+#endif
+}
+
+static bool load(grader_state_t *s, const sudoku_puzzle_t *puzzle) {
+    s->path = NULL;
+    memset(s->grid, 0, sizeof(s->grid));
+    for (int cell = 0; cell < 81; cell++) {
+        s->cand[cell] = ALL_CANDIDATES;
+    }
+    s->empty = 81;
+
+    for (int cell = 0; cell < 81; cell++) {
+        uint8_t num = puzzle->grid[cell];
+        if (num == 0) {
+            continue;
+        }
+        if (!(s->cand[cell] & (1U << (num - 1)))) {
+            return false;
+        }
+        place(s, cell, num);
+    }
+    return true;
+}
+
+// Every empty cell still has a candidate and every unit still has room
+// for each of its missing digits.
+static bool consistent(const grader_state_t *s) {
+    for (int cell = 0; cell < 81; cell++) {
+        if (s->grid[cell] == 0 && s->cand[cell] == 0) {
+            return false;
+        }
+    }
+    for (int unit = 0; unit < UNIT_COUNT; unit++) {
+        uint16_t seen = 0;
+        for (int k = 0; k < 9; k++) {
+            int cell = unit_cells[unit][k];
+            seen |= s->grid[cell] ? 1U << (s->grid[cell] - 1) : s->cand[cell];
+        }
+        if (seen != ALL_CANDIDATES) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Each technique returns how many times it applied, zero if it found
+// nothing to do.
+
+static int hidden_single(grader_state_t *s) {
+    int placed = 0;
+    for (int unit = 0; unit < UNIT_COUNT; unit++) {
+        uint16_t once = 0, twice = 0;
+        for (int k = 0; k < 9; k++) {
+            uint16_t cands = s->cand[unit_cells[unit][k]];
+            twice |= once & cands;
+            once |= cands;
+        }
+
+        uint16_t singles = once & ~twice;
+        while (singles) {
+            uint16_t bit = singles & -singles;
+            singles &= singles - 1;
+            for (int k = 0; k < 9; k++) {
+                int cell = unit_cells[unit][k];
+                if (s->cand[cell] & bit) {
+                    place(s, cell, (uint8_t)__builtin_ctz(bit) + 1);
+                    placed++;
+                    break;
+                }
+            }
+        }
+    }
+    return placed;
+}
+
+static int naked_single(grader_state_t *s) {
+    int placed = 0;
+    for (int cell = 0; cell < 81; cell++) {
+        uint16_t cands = s->cand[cell];
+        if (cands && (cands & (cands - 1)) == 0) {
+            place(s, cell, (uint8_t)__builtin_ctz(cands) + 1);
+            placed++;
+        }
+    }
+    return placed;
+}
+
+// Removes bit from the cells of unit outside of the cells in keep, a
+// bitmask of positions within the unit.
+static bool eliminate_in_unit(grader_state_t *s, int unit, uint16_t keep,
+                              uint16_t bits) {
+    bool changed = false;
+    for (int k = 0; k < 9; k++) {
+        int cell = unit_cells[unit][k];
+        if (!(keep & (1U << k)) && (s->cand[cell] & bits)) {
+            s->cand[cell] &= ~bits;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+static inline bool in_unit(int cell, int unit) {
+    for (int i = 0; i < CELL_UNITS; i++) {
+        if (cell_units[cell][i] == unit) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// A digit whose places in one unit all lie in a second unit can go from
+// the rest of the second. Box against line is pointing, line against box
+// is claiming; variant units overlap the classic ones the same way.
+static int locked_candidates(grader_state_t *s) {
+    for (int unit = 0; unit < UNIT_COUNT; unit++) {
+        for (int d = 0; d < 9; d++) {
+            uint16_t bit = 1U << d;
+            uint8_t cells[9];
+            int n = 0;
+            for (int k = 0; k < 9; k++) {
+                if (s->cand[unit_cells[unit][k]] & bit) {
+                    cells[n++] = unit_cells[unit][k];
+                }
+            }
+            if (n < 2) {
+                continue;
+            }
+
+            // Any unit holding all of them is one of the first cell's.
+            for (int i = 0; i < CELL_UNITS; i++) {
+                int other = cell_units[cells[0]][i];
+                bool shared = other != unit;
+                for (int j = 1; j < n && shared; j++) {
+                    shared = in_unit(cells[j], other);
+                }
+                if (!shared) {
+                    continue;
+                }
+
+                uint16_t keep = 0;
+                for (int k = 0; k < 9; k++) {
+                    if (in_unit(unit_cells[other][k], unit)) {
+                        keep |= 1U << k;
+                    }
+                }
+                if (eliminate_in_unit(s, other, keep, bit)) {
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// No popcount instruction on the M33, and libgcc's fallback is a call.
+static inline int popcount9(uint16_t x) {
+    x = x - ((x >> 1) & 0x5555);
+    x = (x & 0x3333) + ((x >> 2) & 0x3333);
+    x = (x + (x >> 4)) & 0x0F0F;
+    return (x + (x >> 8)) & 0x1F;
+}
+
+// Naked subsets, hidden subsets and fish all come down to the same search:
+// k of nine masks whose union has exactly k bits. Each match found is
+// handed to eliminate until one of them makes progress.
+typedef bool (*subset_fn)(grader_state_t *s, int base, uint16_t members,
+                          uint16_t cover);
+
+typedef struct {
+    grader_state_t *s;
+    int base;
+    const uint16_t *masks;
+    uint8_t usable[9];
+    int n, k;
+    subset_fn eliminate;
+} subset_search_t;
+
+static bool extend_subset(const subset_search_t *q, int from, int size,
+                          uint16_t members, uint16_t cover) {
+    if (size == q->k) {
+        return popcount9(cover) == q->k &&
+               q->eliminate(q->s, q->base, members, cover);
+    }
+    for (int i = from; i < q->n; i++) {
+        int m = q->usable[i];
+        uint16_t next = cover | q->masks[m];
+        if (popcount9(next) <= q->k &&
+            extend_subset(q, i + 1, size + 1, members | (1U << m), next)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool find_subsets(grader_state_t *s, int base, const uint16_t *masks,
+                         int k, subset_fn eliminate) {
+    subset_search_t q = {.s = s, .base = base, .masks = masks, .k = k,
+                         .eliminate = eliminate};
+    for (int i = 0; i < 9; i++) {
+        if (masks[i] && popcount9(masks[i]) <= k) {
+            q.usable[q.n++] = (uint8_t)i;
+        }
+    }
+    return q.n >= k && extend_subset(&q, 0, 0, 0, 0);
+}
+
+// members: positions in the unit; cover: the digits they are limited to.
+static bool naked_eliminate(grader_state_t *s, int unit, uint16_t members,
+                            uint16_t cover) {
+    return eliminate_in_unit(s, unit, members, cover);
+}
+
+// members: digits; cover: the only positions in the unit they can take.
+static bool hidden_eliminate(grader_state_t *s, int unit, uint16_t members,
+                             uint16_t cover) {
+    bool changed = false;
+    for (int k = 0; k < 9; k++) {
+        int cell = unit_cells[unit][k];
+        if ((cover & (1U << k)) && (s->cand[cell] & ~members)) {
+            s->cand[cell] &= members;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// base is the digit, plus 9 when the fish is based on columns. members:
+// base lines; cover: the crossing lines the digit is limited to on them.
+static bool fish_eliminate(grader_state_t *s, int base, uint16_t members,
+                           uint16_t cover) {
+    int d = base % 9, cross = base < 9 ? 9 : 0;
+    bool changed = false;
+    for (int line = 0; line < 9; line++) {
+        if (cover & (1U << line)) {
+            changed |= eliminate_in_unit(s, cross + line, members, 1U << d);
+        }
+    }
+    return changed;
+}
+
+static int subset(grader_state_t *s, bool hidden) {
+    for (int k = 2; k <= 3; k++) {
+        for (int unit = 0; unit < UNIT_COUNT; unit++) {
+            uint16_t masks[9] = {0};
+            for (int i = 0; i < 9; i++) {
+                uint16_t cands = s->cand[unit_cells[unit][i]];
+                if (hidden) {
+                    for (int d = 0; d < 9; d++) {
+                        if (cands & (1U << d)) {
+                            masks[d] |= 1U << i;
+                        }
+                    }
+                } else {
+                    masks[i] = cands;
+                }
+            }
+            if (find_subsets(s, unit, masks, k,
+                             hidden ? hidden_eliminate : naked_eliminate)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int naked_subset(grader_state_t *s) { return subset(s, false); }
+static int hidden_subset(grader_state_t *s) { return subset(s, true); }
+
+static int fish(grader_state_t *s, int k) {
+    for (int base = 0; base < 18; base++) {
+        uint16_t bit = 1U << (base % 9);
+        uint16_t masks[9] = {0};
+        for (int line = 0; line < 9; line++) {
+            for (int i = 0; i < 9; i++) {
+                int cell = base < 9 ? line * 9 + i : i * 9 + line;
+                if (s->cand[cell] & bit) {
+                    masks[line] |= 1U << i;
+                }
+            }
+        }
+        if (find_subsets(s, base, masks, k, fish_eliminate)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int x_wing(grader_state_t *s) { return fish(s, 2); }
+static int swordfish(grader_state_t *s) { return fish(s, 3); }
+
+typedef int (*technique_fn)(grader_state_t *s);
+
+static const technique_fn techniques[TECHNIQUE_GUESS] = {
+    [TECHNIQUE_HIDDEN_SINGLE] = hidden_single,
+    [TECHNIQUE_NAKED_SINGLE] = naked_single,
+    [TECHNIQUE_LOCKED_CANDIDATES] = locked_candidates,
+    [TECHNIQUE_NAKED_SUBSET] = naked_subset,
+    [TECHNIQUE_HIDDEN_SUBSET] = hidden_subset,
+    [TECHNIQUE_X_WING] = x_wing,
+    [TECHNIQUE_SWORDFISH] = swordfish,
+};
+
+// Loosely follows the usual community ratings, in tenths.
+static const uint8_t technique_cost[TECHNIQUE_COUNT] = {
+    [TECHNIQUE_HIDDEN_SINGLE] = 12,
+    [TECHNIQUE_NAKED_SINGLE] = 23,
+    [TECHNIQUE_LOCKED_CANDIDATES] = 26,
+    [TECHNIQUE_NAKED_SUBSET] = 30,
+    [TECHNIQUE_HIDDEN_SUBSET] = 34,
+    [TECHNIQUE_X_WING] = 36,
+    [TECHNIQUE_SWORDFISH] = 40,
+    [TECHNIQUE_GUESS] = 100,
+};
+
+static const char *const technique_names[TECHNIQUE_COUNT] = {
+    [TECHNIQUE_HIDDEN_SINGLE] = "hidden single",
+    [TECHNIQUE_NAKED_SINGLE] = "naked single",
+    [TECHNIQUE_LOCKED_CANDIDATES] = "locked candidates",
+    [TECHNIQUE_NAKED_SUBSET] = "naked subset",
+    [TECHNIQUE_HIDDEN_SUBSET] = "hidden subset",
+    [TECHNIQUE_X_WING] = "x-wing",
+    [TECHNIQUE_SWORDFISH] = "swordfish",
+    [TECHNIQUE_GUESS] = "guess",
+};
+
+// The empty cell with the fewest candidates, which is where a player
+// would guess.
+static int guess_cell(const grader_state_t *s) {
+    int best = -1;
+    for (int cell = 0; cell < 81; cell++) {
+        if (s->cand[cell] &&
+            (best < 0 || popcount9(s->cand[cell]) < popcount9(s->cand[best]))) {
+            best = cell;
+        }
+    }
+    return best;
+}
+
+// Techniques above `limit` are never tried: the solve stops there and
+// fails, with grade->hardest set to the next technique up.
+static bool solve(const sudoku_puzzle_t *puzzle, grade_t *grade,
+                  solve_path_t *path, technique_t limit) {
+    grader_state_t s;
+    memset(grade, 0, sizeof(*grade));
+    if (!load(&s, puzzle) || !consistent(&s)) {
+        return false;
+    }
+    if (path) {
+        path->length = 0;
+    }
+    s.path = path;
+    s.since = TECHNIQUE_HIDDEN_SINGLE;
+    s.step = 0;
+
+    // The grade is final at the first guess; only the path goes on.
+    bool graded = false;
+    while (s.empty > 0) {
+        technique_t t = TECHNIQUE_HIDDEN_SINGLE;
+        int applied = 0;
+        while (t < TECHNIQUE_GUESS && t <= limit &&
+               (s.technique = t, applied = techniques[t](&s)) == 0) {
+            t++;
+        }
+        if (t > limit) {
+            grade->hardest = t;
+            return false;
+        }
+
+        if (!graded) {
+            if (t > grade->hardest) {
+                grade->hardest = t;
+            }
+            if (t == TECHNIQUE_GUESS) {
+                grade->uses[t]++;
+                grade->score += technique_cost[t];
+                graded = true;
+            } else {
+                grade->uses[t] += (uint8_t)applied;
+                grade->score += (uint16_t)(applied * technique_cost[t]);
+                grade->steps++;
+            }
+        }
+
+        if (t == TECHNIQUE_GUESS) {
+            int cell = guess_cell(&s);
+            if (!path || puzzle->solution[cell] == 0 ||
+                !(s.cand[cell] & (1U << (puzzle->solution[cell] - 1)))) {
+                break;
+            }
+            s.technique = TECHNIQUE_GUESS;
+            place(&s, cell, puzzle->solution[cell]);
+        } else if (t > s.since && t > TECHNIQUE_NAKED_SINGLE) {
+            s.since = t;
+        }
+
+        if (s.step < UINT8_MAX) {
+            s.step++;
+        }
+        if (!consistent(&s)) {
+            return graded;
+        }
+    }
+
+    return true;
+}
+
+bool grader_solve_path(const sudoku_puzzle_t *puzzle, grade_t *grade,
+                       solve_path_t *path) {
+    return solve(puzzle, grade, path, TECHNIQUE_GUESS);
+}
+
+bool grader_grade(const sudoku_puzzle_t *puzzle, grade_t *grade) {
+    return solve(puzzle, grade, NULL, TECHNIQUE_GUESS);
+}
+
+bool grader_grade_within(const sudoku_puzzle_t *puzzle, technique_t max,
+                         grade_t *grade) {
+    return solve(puzzle, grade, NULL, max);
+}
+
+uint8_t grader_technique_cost(technique_t technique) {
+    return technique < TECHNIQUE_COUNT ? technique_cost[technique] : 0;
+}
+
+const char *grader_technique_name(technique_t technique) {
+    return technique < TECHNIQUE_COUNT ? technique_names[technique] : "?";
+}
+
+technique_t grader_tier_min(difficulty_t difficulty) {
+    switch (difficulty) {
+    case DIFFICULTY_MEDIUM:
+        return TECHNIQUE_LOCKED_CANDIDATES;
+    case DIFFICULTY_HARD:
+        return TECHNIQUE_X_WING;
+    default:
+        return TECHNIQUE_HIDDEN_SINGLE;
+    }
+}
+
+technique_t grader_tier_max(difficulty_t difficulty) {
+    switch (difficulty) {
+    case DIFFICULTY_MEDIUM:
+        return TECHNIQUE_HIDDEN_SUBSET;
+    case DIFFICULTY_HARD:
+        return TECHNIQUE_GUESS;
+    default:
+        return TECHNIQUE_NAKED_SINGLE;
+    }
+}
@@ -0,0 +1,80 @@
+#include "hint.h"
+#include <string.h>
+
+static inline bool correct(const sudoku_puzzle_t *puzzle, int cell) {
+    return puzzle->grid[cell] == puzzle->solution[cell];
+}
+
+static void index_path(hint_t *hint) {
+    memset(hint->position, HINT_BASE, sizeof(hint->position));
+    for (int i = 0; i < hint->path.length; i++) {
+        hint->position[hint->path.steps[i].cell] = (uint8_t)i;
+    }
+    hint->next = 0;
+    hint->stale = false;
+}
+
+// Solves again from the digits on the board that are right, leaving the
+// wrong ones on the path to be corrected in turn.
+static void resolve(hint_t *hint, const sudoku_puzzle_t *puzzle) {
+    sudoku_puzzle_t base = *puzzle;
+    for (int cell = 0; cell < 81; cell++) {
+        if (!correct(puzzle, cell)) {
+            base.grid[cell] = 0;
+        }
+    }
+
+    grade_t grade;
+    if (!grader_solve_path(&base, &grade, &hint->path)) {
+        hint->path.length = 0;
+    }
+    index_path(hint);
+}
+
+void hint_init(hint_t *hint, const sudoku_puzzle_t *puzzle,
+               const solve_path_t *path) {
+    if (path) {
+        hint->path = *path;
+        index_path(hint);
+    } else {
+        resolve(hint, puzzle);
+    }
+}
+
+void hint_update(hint_t *hint, const sudoku_puzzle_t *puzzle, int cell) {
+    if (correct(puzzle, cell)) {
+        return;
+    }
+    uint8_t position = hint->position[cell];
+    if (position == HINT_BASE) {
+        hint->stale = true;
+    } else if (position < hint->next) {
+        hint->next = position;
+    }
+}
+
+int hint_next(hint_t *hint, const sudoku_puzzle_t *puzzle,
+              technique_t *technique) {
+    if (hint->stale) {
+        resolve(hint, puzzle);
+    }
+
+    while (hint->next < hint->path.length) {
+        const path_step_t *step = &hint->path.steps[hint->next];
+        if (!correct(puzzle, step->cell)) {
+            *technique = (technique_t)step->technique;
+            return step->cell;
+        }
+        hint->next++;
+    }
+
+    // Only reached with the path done, or cut short by a board the
+    // grader could not follow; any wrong cell left is still worth a hint.
+    for (int cell = 0; cell < 81; cell++) {
+        if (!correct(puzzle, cell)) {
+            *technique = TECHNIQUE_GUESS;
+            return cell;
+        }
+    }
+    return -1;
+}
@@ -1,10 +1,18 @@
 #include "hub75.h"
 #include "hub75.pio.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
 #include "hardware/pio.h"
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
 #include "hardware/sync.h"
-#include "pico/multicore.h"
 #include "pico/stdlib.h"
+#include <math.h>
+#include <string.h>
+
+#if HUB75_COLOR_DEPTH < 4 || HUB75_COLOR_DEPTH > 10
+#error "HUB75_COLOR_DEPTH must be between 4 and 10"
+#endif
 
 #define HUB75_R1_PIN 6U
 #define HUB75_G1_PIN 7U
@@ -22,9 +30,64 @@
 #define HUB75_LAT_PIN 19U
 #define HUB75_OE_PIN 20U
 
+#define HUB75_ROWS (HUB75_PANEL_HEIGHT / 2)
+// One slot is one row pair of one bit-plane; a frame is every slot once.
+#define HUB75_SLOTS (HUB75_COLOR_DEPTH * HUB75_ROWS)
+
+// Both state machines run at sys_clk / HUB75_PIO_CLKDIV. The data one takes
+// two cycles per column, plus a few around each row, and the next row is
+// shifted in while the current one is lit. Latching and moving on to the
+// next row costs the row one a few more with OE off.
+#define HUB75_PIO_CLKDIV 4
+#define HUB75_SHIFT_CYCLES (2 * HUB75_PANEL_WIDTH + 3)
+#define HUB75_LATCH_CYCLES 7
+
+#define HUB75_GAMMA 2.2f
+
 static PIO pio = pio0;
-static unsigned sm;
-static uint8_t framebuffer[HUB75_PANEL_HEIGHT][HUB75_PANEL_WIDTH][3];
+static unsigned data_sm;
+static unsigned row_sm;
+// The framebuffer is kept the way the panel is scanned: for every slot, in
+// scan order, one ready-made PIO word per column, holding R1 G1 B1 of
+// the top row in bits 0-2 and R2 G2 B2 of the bottom row in bits 3-5.
+// Pixels are sliced into planes as they are written, so a refresh only
+// streams words. There are three of them, so drawing never has to wait:
+// one is scanned, one may be handed over and waiting for the next frame
+// boundary, and drawing goes to planes[back].
+static uint8_t planes[3][HUB75_SLOTS][HUB75_PANEL_WIDTH];
+// What hub75_row needs for each slot, in scan order.
+static uint32_t row_words[HUB75_SLOTS];
+// 8-bit channel values to HUB75_COLOR_DEPTH bits, perceptually even.
+static uint16_t gamma_lut[256];
+
+// Where each DMA loop starts over; the control channels copy these back
+// into the data channels' read address at the end of every frame. A new
+// frame is handed over by pointing planes_start at it, which the scan
+// only takes up at the next frame boundary.
+static const void *volatile planes_start = planes[0];
+static const void *volatile row_words_start = row_words;
+static unsigned planes_channel;
+static unsigned planes_control;
+
+// The buffer being scanned, as seen at the last frame boundary, and the
+// one last handed over; they differ until the scan takes it up.
+static volatile unsigned shown = 0;
+static unsigned queued = 0;
+static unsigned back = 1;
+static bool dirty = false;
+
+// Indexed mode keeps two pixels per byte, the left one in the low nibble,
+// and each palette entry as the R G B bits it puts on every plane.
+static bool indexed = false;
+static uint8_t indices[HUB75_PANEL_HEIGHT][HUB75_PANEL_WIDTH / 2];
+static uint8_t palette[HUB75_PALETTE_SIZE][HUB75_COLOR_DEPTH];
+
+// For hub75_get_timing().
+static volatile uint32_t frames = 0;
+static uint64_t start_us;
+static uint32_t pio_hz;
+static uint32_t lsb_cycles;
+static uint32_t oe_cycles;
 
 static float cursor_x = 0;
 static float cursor_y = 0;
@@ -33,120 +96,239 @@ static float target_y = 0;
 
 static const float lerp_speed = .3f;
 
-static volatile bool is_reading = false;
-static volatile uint32_t last_write = 0;
-static volatile bool refresh_lock = false;
-
-static void set_row_address(uint8_t row) {
-    gpio_put(HUB75_A_PIN, row & 0x1U);
-    gpio_put(HUB75_B_PIN, row & 0x2U);
-    gpio_put(HUB75_C_PIN, row & 0x4U);
-    gpio_put(HUB75_D_PIN, row & 0x8U);
-}
-
-static void refresh_row(uint8_t row, uint8_t bit) {
-    uint8_t row_top = row;
-    uint8_t row_bot = row + (HUB75_PANEL_HEIGHT / 2);
-    uint8_t mask = 1U << (8 - HUB75_COLOR_DEPTH + bit);
-
-    gpio_put(HUB75_OE_PIN, 1);
-
-    for (int x = 0; x < HUB75_PANEL_WIDTH; ++x) {
-        unsigned pixel =
-            ((framebuffer[row_top][x][0] & mask) ? (1U << 0) : 0) |
-            ((framebuffer[row_top][x][1] & mask) ? (1U << 1) : 0) |
-            ((framebuffer[row_top][x][2] & mask) ? (1U << 2) : 0) |
-            ((framebuffer[row_bot][x][0] & mask) ? (1U << 3) : 0) |
-            ((framebuffer[row_bot][x][1] & mask) ? (1U << 4) : 0) |
-            ((framebuffer[row_bot][x][2] & mask) ? (1U << 5) : 0);
-        pio->txf[sm] = pixel; 
-    }
+// The D line sits on HUB75_D_PIN rather than right after C, so the row
+// number is spread over the address pins the same way.
+static uint32_t row_address(uint8_t row) {
+    return (row & 0x7U) | (uint32_t)(row & 0x8U) << (HUB75_D_PIN - HUB75_C_PIN - 1);
+}
+
+// Frames are scanned in HUB75_COLOR_DEPTH passes over the rows, with each
+// row showing a different plane in every pass: row r gets plane
+// (pass + r) % HUB75_COLOR_DEPTH. The long planes are thus spread over the
+// whole frame instead of lighting the panel in one burst, which is what
+// shows up as flicker on camera.
+static inline unsigned slot(unsigned bit, unsigned row) {
+    const unsigned pass = (bit + HUB75_COLOR_DEPTH - row % HUB75_COLOR_DEPTH) %
+                          HUB75_COLOR_DEPTH;
+    return pass * HUB75_ROWS + row;
+}
 
-    while (!pio_sm_is_tx_fifo_empty(pio, sm)) {
-        tight_loop_contents();
+// PIO cycles per frame with the given OE time for the least significant
+// plane. Planes too short to cover the next row's shift wait for it.
+static uint32_t frame_cycles(uint32_t lsb) {
+    uint32_t cycles = 0;
+    for (unsigned bit = 0; bit < HUB75_COLOR_DEPTH; ++bit) {
+        const uint32_t oe = lsb << bit;
+        cycles += HUB75_ROWS *
+                  ((oe > HUB75_SHIFT_CYCLES ? oe : HUB75_SHIFT_CYCLES) + HUB75_LATCH_CYCLES);
     }
+    return cycles;
+}
+
+// Makes `channel` stream `count` words of `size` from *start into the TX
+// FIFO of `sm`, with `control` pointing it back at *start once done, so
+// the two keep going on their own.
+static void dma_loop(unsigned channel, unsigned control, unsigned sm,
+                     const void *volatile *start, unsigned count,
+                     enum dma_channel_transfer_size size) {
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&c, size);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    channel_config_set_chain_to(&c, control);
+    dma_channel_configure(channel, &c, &pio->txf[sm], *start, count, false);
+
+    c = dma_channel_get_default_config(control);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(control, &c, &dma_hw->ch[channel].al3_read_addr_trig,
+                          start, 1, false);
+}
+
+// Runs once the planes loop has been pointed back at the start of a
+// frame. By then its read address is a few bytes into the buffer it took,
+// which tells them apart.
+static void hub75_frame_handler(void) {
+    dma_channel_acknowledge_irq0(planes_control);
+    const uintptr_t read = (uintptr_t)dma_channel_hw_addr(planes_channel)->read_addr;
+    shown = (unsigned)((read - (uintptr_t)planes[0]) / sizeof(planes[0]));
+    frames++;
+}
 
-    set_row_address(row);
-    gpio_put(HUB75_LAT_PIN, 1);
-    gpio_put(HUB75_LAT_PIN, 0);
+// The R G B bits a gamma-corrected colour puts on plane `bit`.
+static inline uint8_t plane_bits(unsigned red, unsigned green, unsigned blue,
+                                 unsigned bit) {
+    return (uint8_t)(((red >> bit) & 1U) | ((green >> bit) & 1U) << 1 |
+                     ((blue >> bit) & 1U) << 2);
+}
 
-    gpio_put(HUB75_OE_PIN, 0);
-    sleep_us(4U << bit);
-    gpio_put(HUB75_OE_PIN, 1);
+static inline unsigned index_at(unsigned x, unsigned y) {
+    return (indices[y][x / 2] >> (x % 2 * 4)) & 0xFU;
 }
 
-void hub75_refresh(void) {
-    is_reading = true;
-    for (uint8_t bit = 0; bit < HUB75_COLOR_DEPTH; ++bit) {
-        for (uint8_t row = 0; row <  HUB75_PANEL_HEIGHT / 2; ++row) {
-            refresh_row(row, bit);
+// Writes the whole indexed frame into the back planes, one palette lookup
+// per pixel.
+static void expand_indices(void) {
+    for (unsigned row = 0; row < HUB75_ROWS; ++row) {
+        for (unsigned x = 0; x < HUB75_PANEL_WIDTH; ++x) {
+            const uint8_t *top = palette[index_at(x, row)];
+            const uint8_t *bottom = palette[index_at(x, row + HUB75_ROWS)];
+            for (unsigned bit = 0; bit < HUB75_COLOR_DEPTH; ++bit) {
+                planes[back][slot(bit, row)][x] = (uint8_t)(top[bit] | bottom[bit] << 3);
+            }
         }
     }
-    is_reading = false;
 }
 
-void hub75_spin() {
-    while (1) {
-        if (!refresh_lock && (time_us_32() - last_write) >= 1000) {
-            hub75_refresh();
-            sleep_ms(1);
+bool hub75_present(void) {
+    if (!dirty) {
+        return true;
+    }
+    // Only one frame is handed over at a time. Until the scan takes it up,
+    // this one stays in the back buffer, which nothing reads. The scan may
+    // move on at any point below, so `shown` is read once.
+    const unsigned front = shown;
+    if (front != queued) {
+        return false;
+    }
+    if (indexed) {
+        expand_indices();
+    }
+    // The frame has to be in memory before the DMA can be pointed at it.
+    __dmb();
+    planes_start = planes[back];
+    queued = back;
+    // Of the other two, one is being scanned and the third is free. Carry
+    // the frame over so drawing can go on from it; an indexed frame is
+    // expanded afresh every time.
+    back = 3 - front - queued;
+    if (!indexed) {
+        memcpy(planes[back], planes[queued], sizeof(planes[back]));
+    }
+    dirty = false;
+    return true;
+}
+
+void hub75_set_pixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b) {
+    if (!indexed && x < HUB75_PANEL_WIDTH && y < HUB75_PANEL_HEIGHT) {
+        const unsigned row = y % HUB75_ROWS;
+        const unsigned shift = y < HUB75_ROWS ? 0 : 3;
+        const unsigned red = gamma_lut[r];
+        const unsigned green = gamma_lut[g];
+        const unsigned blue = gamma_lut[b];
+        for (unsigned bit = 0; bit < HUB75_COLOR_DEPTH; ++bit) {
+            const unsigned rgb = plane_bits(red, green, blue, bit);
+            uint8_t *word = &planes[back][slot(bit, row)][x];
+            *word = (uint8_t)((*word & ~(7U << shift)) | rgb << shift);
         }
+        dirty = true;
     }
 }
 
-void lock_refresh() {
-    refresh_lock = true;
+void hub75_clear(void) {
+    if (indexed) {
+        memset(indices, 0, sizeof(indices));
+    } else {
+        memset(planes[back], 0, sizeof(planes[back]));
+    }
+    dirty = true;
 }
 
-void unlock_refresh() {
-    refresh_lock = false;
+void hub75_set_indexed(bool on) {
+    if (on != indexed) {
+        indexed = on;
+        hub75_clear();
+    }
 }
 
-void hub75_set_pixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b) {
-    while (is_reading) {
-        tight_loop_contents();
+void hub75_set_palette(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index < HUB75_PALETTE_SIZE) {
+        const unsigned red = gamma_lut[r];
+        const unsigned green = gamma_lut[g];
+        const unsigned blue = gamma_lut[b];
+        for (unsigned bit = 0; bit < HUB75_COLOR_DEPTH; ++bit) {
+            palette[index][bit] = plane_bits(red, green, blue, bit);
+        }
+        dirty |= indexed;
     }
-    if (x < HUB75_PANEL_WIDTH && y < HUB75_PANEL_HEIGHT) {
-        framebuffer[y][x][0] = r;
-        framebuffer[y][x][1] = g;
-        framebuffer[y][x][2] = b;
+}
+
+void hub75_set_index(uint8_t x, uint8_t y, uint8_t index) {
+    if (indexed && x < HUB75_PANEL_WIDTH && y < HUB75_PANEL_HEIGHT) {
+        const unsigned shift = x % 2 * 4;
+        uint8_t *pair = &indices[y][x / 2];
+        *pair = (uint8_t)((*pair & ~(0xFU << shift)) | (index & 0xFU) << shift);
+        dirty = true;
     }
-    last_write = time_us_32() / 1000;
 }
 
-void hub75_clear(void) {
-    while (is_reading) {
-        tight_loop_contents();
+// Starts the scan. From here on the panel is refreshed by the PIO and DMA,
+// with one interrupt per frame to note which buffer is up; drawing only
+// has to write the planes.
+void hub75_init(void) {
+    memset(planes, 0, sizeof(planes));
+
+    const float top = (float)((1U << HUB75_COLOR_DEPTH) - 1);
+    for (unsigned i = 0; i < 256; ++i) {
+        gamma_lut[i] = (uint16_t)(powf(i / 255.0f, HUB75_GAMMA) * top + 0.5f);
     }
-    for (int y = 0; y < HUB75_PANEL_HEIGHT; y++) {
-        for (int x = 0; x < HUB75_PANEL_WIDTH; x++) {
-            framebuffer[y][x][0] = 0;
-            framebuffer[y][x][1] = 0;
-            framebuffer[y][x][2] = 0;
+
+    // The longest LSB time that still fits the frame into the target
+    // period; below one cycle the target cannot be met and the panel
+    // simply refreshes slower.
+    pio_hz = clock_get_hz(clk_sys) / HUB75_PIO_CLKDIV;
+    const uint32_t budget = pio_hz / HUB75_REFRESH_HZ;
+    lsb_cycles = budget / (HUB75_ROWS * ((1U << HUB75_COLOR_DEPTH) - 1));
+    while (lsb_cycles > 1 && frame_cycles(lsb_cycles) > budget) {
+        lsb_cycles--;
+    }
+    if (lsb_cycles == 0) {
+        lsb_cycles = 1;
+    }
+    oe_cycles = HUB75_ROWS * ((1U << HUB75_COLOR_DEPTH) - 1) * lsb_cycles;
+
+    for (unsigned bit = 0; bit < HUB75_COLOR_DEPTH; ++bit) {
+        for (uint8_t row = 0; row < HUB75_ROWS; ++row) {
+            row_words[slot(bit, row)] = row_address(row) | ((lsb_cycles << bit) - 1) << 5;
         }
     }
-    last_write = time_us_32() / 1000;
+
+    const uint32_t address_pins = (1U << HUB75_A_PIN) | (1U << HUB75_B_PIN) |
+                                  (1U << HUB75_C_PIN) | (1U << HUB75_D_PIN);
+    data_sm = pio_claim_unused_sm(pio, true);
+    row_sm = pio_claim_unused_sm(pio, true);
+    hub75_data_program_init(pio, data_sm, pio_add_program(pio, &hub75_data_program),
+                            HUB75_R1_PIN, HUB75_CLK_PIN, HUB75_PIO_CLKDIV);
+    hub75_row_program_init(pio, row_sm, pio_add_program(pio, &hub75_row_program),
+                           HUB75_A_PIN, address_pins, HUB75_LAT_PIN, HUB75_PIO_CLKDIV);
+    pio_interrupt_clear(pio, 0);
+    pio_interrupt_clear(pio, 1);
+
+    planes_channel = dma_claim_unused_channel(true);
+    planes_control = dma_claim_unused_channel(true);
+    const unsigned row_channel = dma_claim_unused_channel(true);
+    dma_loop(planes_channel, planes_control, data_sm, &planes_start,
+             sizeof(planes[0]), DMA_SIZE_8);
+    dma_loop(row_channel, dma_claim_unused_channel(true), row_sm, &row_words_start,
+             HUB75_SLOTS, DMA_SIZE_32);
+
+    dma_channel_set_irq0_enabled(planes_control, true);
+    irq_set_exclusive_handler(DMA_IRQ_0, hub75_frame_handler);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    dma_start_channel_mask((1U << planes_channel) | (1U << row_channel));
+
+    start_us = time_us_64();
+    pio_enable_sm_mask_in_sync(pio, (1U << data_sm) | (1U << row_sm));
 }
 
-void hub75_init(void) {
-    const uint8_t ctrl_pins[] = {
-        HUB75_A_PIN, HUB75_B_PIN, HUB75_C_PIN, HUB75_D_PIN,
-        HUB75_LAT_PIN,
-        HUB75_OE_PIN,
-    };
-    for (int i = 0; i < sizeof(ctrl_pins); i++) {
-        gpio_init(ctrl_pins[i]);
-        gpio_set_dir(ctrl_pins[i], GPIO_OUT);
-    }
-    
-    gpio_put(HUB75_OE_PIN, 1);
-    gpio_put(HUB75_LAT_PIN, 0);
-
-    unsigned offset = pio_add_program(pio, &hub75_program);
-    sm = pio_claim_unused_sm(pio, true);
-    hub75_program_init(pio, sm, offset, HUB75_R1_PIN);
-    set_row_address(0);
-    hub75_clear();
+void hub75_get_timing(hub75_timing_t *timing) {
+    const uint64_t elapsed_us = time_us_64() - start_us;
+    timing->refresh_hz = elapsed_us ? frames * 1e6f / (float)elapsed_us : 0.0f;
+    timing->duty = timing->refresh_hz * (float)oe_cycles / (float)pio_hz;
+    timing->lsb_ns = lsb_cycles * 1e9f / (float)pio_hz;
 }
 
 void hub75_set_cursor(uint8_t x, uint8_t y) {
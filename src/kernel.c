@@ -0,0 +1,433 @@
+#include "kernel.h"
+#include <string.h>
+
+// The passes only stay in registers once every helper is inlined, which
+// -Os and -O2 will not do on their own.
+#define KERNEL_INLINE inline __attribute__((always_inline))
+
+// Each backend provides a row type holding the 16 lanes of one board row
+// and the same handful of lane-wise operations. The propagation passes
+// below are written once against them.
+//
+// Unit reductions track, per digit, whether it was seen at least once and
+// at least twice. That pair combines associatively, so a row or box is
+// reduced with a couple of fixed rotations that also leave the result in
+// every lane of the unit.
+#if defined(__AVX2__) && !defined(KERNEL_PORTABLE)
+#include <immintrin.h>
+
+#define KERNEL_BACKEND "avx2"
+
+typedef __m256i vrow_t;
+
+static KERNEL_INLINE vrow_t v_load(const uint16_t *lanes) {
+    return _mm256_load_si256((const __m256i *)lanes);
+}
+static KERNEL_INLINE void v_store(uint16_t *lanes, vrow_t v) {
+    _mm256_store_si256((__m256i *)lanes, v);
+}
+static KERNEL_INLINE vrow_t v_zero() { return _mm256_setzero_si256(); }
+static KERNEL_INLINE vrow_t v_and(vrow_t a, vrow_t b) { return _mm256_and_si256(a, b); }
+static KERNEL_INLINE vrow_t v_or(vrow_t a, vrow_t b) { return _mm256_or_si256(a, b); }
+static KERNEL_INLINE vrow_t v_xor(vrow_t a, vrow_t b) { return _mm256_xor_si256(a, b); }
+// a & ~b
+static KERNEL_INLINE vrow_t v_andnot(vrow_t a, vrow_t b) { return _mm256_andnot_si256(b, a); }
+static KERNEL_INLINE bool v_any(vrow_t v) { return !_mm256_testz_si256(v, v); }
+
+static KERNEL_INLINE vrow_t v_eqz(vrow_t v) {
+    return _mm256_cmpeq_epi16(v, _mm256_setzero_si256());
+}
+
+// All ones in lanes holding at most one candidate.
+static KERNEL_INLINE vrow_t v_single(vrow_t v) {
+    vrow_t less = _mm256_sub_epi16(v, _mm256_set1_epi16(1));
+    return v_eqz(_mm256_and_si256(v, less));
+}
+
+#define ROT_GROUP_1 _MM_SHUFFLE(0, 3, 2, 1)
+#define ROT_GROUP_2 _MM_SHUFFLE(1, 0, 3, 2)
+
+static KERNEL_INLINE vrow_t v_rot_lane1(vrow_t v) {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, ROT_GROUP_1), ROT_GROUP_1);
+}
+static KERNEL_INLINE vrow_t v_rot_lane2(vrow_t v) {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, ROT_GROUP_2), ROT_GROUP_2);
+}
+static KERNEL_INLINE vrow_t v_rot_group1(vrow_t v) {
+    return _mm256_permute4x64_epi64(v, ROT_GROUP_1);
+}
+static KERNEL_INLINE vrow_t v_rot_group2(vrow_t v) {
+    return _mm256_permute4x64_epi64(v, ROT_GROUP_2);
+}
+
+#elif defined(__SSE2__) && !defined(KERNEL_PORTABLE)
+#include <emmintrin.h>
+
+#define KERNEL_BACKEND "sse2"
+
+// Lanes 0..7 (box columns 0 and 1) and lanes 8..15 (box column 2).
+typedef struct {
+    __m128i lo, hi;
+} vrow_t;
+
+static KERNEL_INLINE vrow_t v_make(__m128i lo, __m128i hi) {
+    vrow_t v = {lo, hi};
+    return v;
+}
+static KERNEL_INLINE vrow_t v_load(const uint16_t *lanes) {
+    return v_make(_mm_load_si128((const __m128i *)lanes),
+                  _mm_load_si128((const __m128i *)(lanes + 8)));
+}
+static KERNEL_INLINE void v_store(uint16_t *lanes, vrow_t v) {
+    _mm_store_si128((__m128i *)lanes, v.lo);
+    _mm_store_si128((__m128i *)(lanes + 8), v.hi);
+}
+static KERNEL_INLINE vrow_t v_zero() { return v_make(_mm_setzero_si128(), _mm_setzero_si128()); }
+static KERNEL_INLINE vrow_t v_and(vrow_t a, vrow_t b) {
+    return v_make(_mm_and_si128(a.lo, b.lo), _mm_and_si128(a.hi, b.hi));
+}
+static KERNEL_INLINE vrow_t v_or(vrow_t a, vrow_t b) {
+    return v_make(_mm_or_si128(a.lo, b.lo), _mm_or_si128(a.hi, b.hi));
+}
+static KERNEL_INLINE vrow_t v_xor(vrow_t a, vrow_t b) {
+    return v_make(_mm_xor_si128(a.lo, b.lo), _mm_xor_si128(a.hi, b.hi));
+}
+// a & ~b
+static KERNEL_INLINE vrow_t v_andnot(vrow_t a, vrow_t b) {
+    return v_make(_mm_andnot_si128(b.lo, a.lo), _mm_andnot_si128(b.hi, a.hi));
+}
+static KERNEL_INLINE bool v_any(vrow_t v) {
+    __m128i any = _mm_or_si128(v.lo, v.hi);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128())) != 0xFFFF;
+}
+
+static KERNEL_INLINE vrow_t v_eqz(vrow_t v) {
+    const __m128i zero = _mm_setzero_si128();
+    return v_make(_mm_cmpeq_epi16(v.lo, zero), _mm_cmpeq_epi16(v.hi, zero));
+}
+
+// All ones in lanes holding at most one candidate.
+static KERNEL_INLINE vrow_t v_single(vrow_t v) {
+    const __m128i one = _mm_set1_epi16(1);
+    return v_eqz(v_make(_mm_and_si128(v.lo, _mm_sub_epi16(v.lo, one)),
+                        _mm_and_si128(v.hi, _mm_sub_epi16(v.hi, one))));
+}
+
+#define ROT_GROUP_1 _MM_SHUFFLE(0, 3, 2, 1)
+#define ROT_GROUP_2 _MM_SHUFFLE(1, 0, 3, 2)
+
+static KERNEL_INLINE __m128i rot_lane1(__m128i v) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, ROT_GROUP_1), ROT_GROUP_1);
+}
+static KERNEL_INLINE __m128i rot_lane2(__m128i v) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, ROT_GROUP_2), ROT_GROUP_2);
+}
+static KERNEL_INLINE vrow_t v_rot_lane1(vrow_t v) { return v_make(rot_lane1(v.lo), rot_lane1(v.hi)); }
+static KERNEL_INLINE vrow_t v_rot_lane2(vrow_t v) { return v_make(rot_lane2(v.lo), rot_lane2(v.hi)); }
+
+// Groups 0..3 are the 64-bit halves of lo and hi in order.
+static KERNEL_INLINE __m128i join_halves(__m128i a, __m128i b) {
+    return _mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b), 1));
+}
+static KERNEL_INLINE vrow_t v_rot_group1(vrow_t v) {
+    return v_make(join_halves(v.lo, v.hi), join_halves(v.hi, v.lo));
+}
+static KERNEL_INLINE vrow_t v_rot_group2(vrow_t v) { return v_make(v.hi, v.lo); }
+
+#else
+
+// Two lanes per 32-bit word. Only the twelve lanes of the three box
+// columns are carried; the padding group is implicitly zero.
+#if defined(__ARM_FEATURE_SIMD32) && !defined(KERNEL_PORTABLE)
+#include <arm_acle.h>
+#define KERNEL_BACKEND "swar-dsp"
+#else
+#define KERNEL_BACKEND "swar"
+#endif
+
+#define LANE_LOW 0x00010001U
+#define LANE_HIGH 0x80008000U
+
+// The word loops must unroll so a row stays in registers.
+#define SWAR_UNROLL _Pragma("GCC unroll 6")
+
+typedef struct {
+    uint32_t w[6];
+} vrow_t;
+
+static KERNEL_INLINE vrow_t v_load(const uint16_t *lanes) {
+    vrow_t v;
+    SWAR_UNROLL
+    for (int i = 0; i < 6; i++) {
+        v.w[i] = lanes[2 * i] | (uint32_t)lanes[2 * i + 1] << 16;
+    }
+    return v;
+}
+static KERNEL_INLINE void v_store(uint16_t *lanes, vrow_t v) {
+    SWAR_UNROLL
+    for (int i = 0; i < 6; i++) {
+        lanes[2 * i] = (uint16_t)v.w[i];
+        lanes[2 * i + 1] = (uint16_t)(v.w[i] >> 16);
+    }
+}
+static KERNEL_INLINE vrow_t v_zero() {
+    vrow_t v = {{0}};
+    return v;
+}
+
+#define SWAR_BINARY(name, op)                                                  \
+    static KERNEL_INLINE vrow_t name(vrow_t a, vrow_t b) {                            \
+        vrow_t r;                                                              \
+        SWAR_UNROLL                                                            \
+        for (int i = 0; i < 6; i++) {                                          \
+            r.w[i] = a.w[i] op b.w[i];                                         \
+        }                                                                      \
+        return r;                                                              \
+    }
+SWAR_BINARY(v_and, &)
+SWAR_BINARY(v_or, |)
+SWAR_BINARY(v_xor, ^)
+SWAR_BINARY(v_andnot, &~)
+#undef SWAR_BINARY
+
+static KERNEL_INLINE bool v_any(vrow_t v) {
+    return (v.w[0] | v.w[1] | v.w[2] | v.w[3] | v.w[4] | v.w[5]) != 0;
+}
+
+// Candidate masks use 9 bits, so the top bit of every lane is free and
+// lane-wise arithmetic never carries into the neighbouring lane.
+static KERNEL_INLINE uint32_t w_eqz(uint32_t x) {
+#if defined(__ARM_FEATURE_SIMD32) && !defined(KERNEL_PORTABLE)
+    // USUB16 sets the GE flags of each lane where x - 1 does not borrow,
+    // that is where x is nonzero; SEL then picks per lane on them.
+    (void)__usub16(x, LANE_LOW);
+    return __sel(0, 0xFFFFFFFFU);
+#else
+    uint32_t nonzero = ((x + (LANE_HIGH - LANE_LOW)) & LANE_HIGH) >> 15;
+    return (nonzero ^ LANE_LOW) * 0xFFFFU;
+#endif
+}
+
+static KERNEL_INLINE uint32_t w_less_one(uint32_t x) {
+#if defined(__ARM_FEATURE_SIMD32) && !defined(KERNEL_PORTABLE)
+    return __usub16(x, LANE_LOW);
+#else
+    return ((x | LANE_HIGH) - LANE_LOW) & ~LANE_HIGH;
+#endif
+}
+
+static KERNEL_INLINE vrow_t v_eqz(vrow_t v) {
+    vrow_t r;
+    SWAR_UNROLL
+    for (int i = 0; i < 6; i++) {
+        r.w[i] = w_eqz(v.w[i]);
+    }
+    return r;
+}
+
+// All ones in lanes holding at most one candidate.
+static KERNEL_INLINE vrow_t v_single(vrow_t v) {
+    vrow_t r;
+    SWAR_UNROLL
+    for (int i = 0; i < 6; i++) {
+        r.w[i] = w_eqz(v.w[i] & w_less_one(v.w[i]));
+    }
+    return r;
+}
+
+static KERNEL_INLINE vrow_t v_rot_lane1(vrow_t v) {
+    vrow_t r;
+    SWAR_UNROLL
+    for (int g = 0; g < 6; g += 2) {
+        r.w[g] = (v.w[g] >> 16) | (v.w[g + 1] << 16);
+        r.w[g + 1] = (v.w[g + 1] >> 16) | (v.w[g] << 16);
+    }
+    return r;
+}
+static KERNEL_INLINE vrow_t v_rot_lane2(vrow_t v) {
+    vrow_t r;
+    SWAR_UNROLL
+    for (int g = 0; g < 6; g += 2) {
+        r.w[g] = v.w[g + 1];
+        r.w[g + 1] = v.w[g];
+    }
+    return r;
+}
+
+// With only three groups carried, the row reduction adds both rotations
+// of the original tally instead of doubling up.
+#define KERNEL_ROW_GROUPS 3
+
+static KERNEL_INLINE vrow_t v_rot_group1(vrow_t v) {
+    vrow_t r = {{v.w[2], v.w[3], v.w[4], v.w[5], v.w[0], v.w[1]}};
+    return r;
+}
+static KERNEL_INLINE vrow_t v_rot_group2(vrow_t v) {
+    vrow_t r = {{v.w[4], v.w[5], v.w[0], v.w[1], v.w[2], v.w[3]}};
+    return r;
+}
+#endif
+
+#ifndef KERNEL_ROW_GROUPS
+#define KERNEL_ROW_GROUPS 4
+#endif
+
+// Digits seen at least once and at least twice in a set of cells.
+typedef struct {
+    vrow_t once, twice;
+} tally_t;
+
+static KERNEL_INLINE tally_t tally_of(vrow_t v) {
+    tally_t t = {v, v_zero()};
+    return t;
+}
+
+static KERNEL_INLINE tally_t tally_add(tally_t a, tally_t b) {
+    tally_t t;
+    t.twice = v_or(v_or(a.twice, b.twice), v_and(a.once, b.once));
+    t.once = v_or(a.once, b.once);
+    return t;
+}
+
+static KERNEL_INLINE tally_t tally_box(tally_t t) {
+    t = tally_add(t, (tally_t){v_rot_lane1(t.once), v_rot_lane1(t.twice)});
+    return tally_add(t, (tally_t){v_rot_lane2(t.once), v_rot_lane2(t.twice)});
+}
+
+// Expects a tally already reduced over each box group.
+static KERNEL_INLINE tally_t tally_row(tally_t t) {
+#if KERNEL_ROW_GROUPS == 3
+    tally_t r = tally_add(t, (tally_t){v_rot_group1(t.once), v_rot_group1(t.twice)});
+    return tally_add(r, (tally_t){v_rot_group2(t.once), v_rot_group2(t.twice)});
+#else
+    t = tally_add(t, (tally_t){v_rot_group1(t.once), v_rot_group1(t.twice)});
+    return tally_add(t, (tally_t){v_rot_group2(t.once), v_rot_group2(t.twice)});
+#endif
+}
+
+// Tallies the rows of v over every column, box and row at once.
+typedef struct {
+    tally_t col;
+    tally_t box[3];
+    tally_t row[9];
+} units_t;
+
+static KERNEL_INLINE void tally_units(const vrow_t *v, units_t *u) {
+    u->col = tally_of(v_zero());
+    for (int band = 0; band < 3; band++) {
+        tally_t box = tally_of(v_zero());
+        for (int r = band * 3; r < band * 3 + 3; r++) {
+            tally_t t = tally_box(tally_of(v[r]));
+            u->row[r] = tally_row(t);
+            box = tally_add(box, tally_of(v[r]));
+            u->col = tally_add(u->col, tally_of(v[r]));
+        }
+        u->box[band] = tally_box(box);
+    }
+}
+
+static const uint16_t valid_lanes[16] __attribute__((aligned(32))) = {
+    0x1FF, 0x1FF, 0x1FF, 0, 0x1FF, 0x1FF, 0x1FF, 0,
+    0x1FF, 0x1FF, 0x1FF, 0, 0,     0,     0,     0,
+};
+
+bool kernel_propagate(kernel_board_t *board) {
+    const vrow_t valid = v_load(valid_lanes);
+    vrow_t rows[9];
+    units_t u;
+
+    for (int r = 0; r < 9; r++) {
+        rows[r] = v_load(board->cand[r]);
+    }
+
+    bool changed = true;
+    while (changed) {
+        // Naked singles: every cell left with one candidate removes it
+        // from its peers. Two singles of one digit in a unit conflict.
+        vrow_t single[9], placed[9];
+        vrow_t bad = v_zero();
+        for (int r = 0; r < 9; r++) {
+            single[r] = v_single(rows[r]);
+            placed[r] = v_and(rows[r], single[r]);
+            bad = v_or(bad, v_and(v_eqz(rows[r]), valid));
+        }
+        if (v_any(bad)) {
+            return false;
+        }
+
+        tally_units(placed, &u);
+        bad = u.col.twice;
+        changed = false;
+        for (int r = 0; r < 9; r++) {
+            bad = v_or(bad, v_or(u.row[r].twice, u.box[r / 3].twice));
+
+            vrow_t seen = v_or(v_or(u.col.once, u.box[r / 3].once), u.row[r].once);
+            vrow_t next = v_or(placed[r], v_andnot(v_andnot(rows[r], single[r]), seen));
+            changed |= v_any(v_xor(next, rows[r]));
+            rows[r] = next;
+        }
+        if (v_any(bad)) {
+            return false;
+        }
+
+        // Hidden singles: a digit with one possible cell in a unit goes
+        // there. Every digit must still have somewhere to go.
+        tally_units(rows, &u);
+        bad = v_andnot(valid, u.col.once);
+        for (int r = 0; r < 9; r++) {
+            const tally_t *box = &u.box[r / 3], *row = &u.row[r];
+            bad = v_or(bad, v_or(v_andnot(valid, box->once), v_andnot(valid, row->once)));
+
+            vrow_t hidden = v_or(v_or(v_andnot(u.col.once, u.col.twice),
+                                      v_andnot(box->once, box->twice)),
+                                 v_andnot(row->once, row->twice));
+            hidden = v_and(rows[r], hidden);
+            bad = v_or(bad, v_andnot(hidden, v_single(hidden)));
+
+            vrow_t next = v_or(v_and(rows[r], v_eqz(hidden)), hidden);
+            changed |= v_any(v_xor(next, rows[r]));
+            rows[r] = next;
+        }
+        if (v_any(bad)) {
+            return false;
+        }
+    }
+
+    for (int r = 0; r < 9; r++) {
+        v_store(board->cand[r], rows[r]);
+    }
+    return true;
+}
+
+void kernel_load(kernel_board_t *board, const sudoku_puzzle_t *puzzle) {
+    memset(board, 0, sizeof(*board));
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            uint8_t num = puzzle->grid[r * 9 + c];
+            board->cand[r][kernel_lane(c)] = num ? (uint16_t)(1U << (num - 1)) : 0x1FF;
+        }
+    }
+}
+
+void kernel_store(const kernel_board_t *board, sudoku_puzzle_t *puzzle) {
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            uint16_t cands = board->cand[r][kernel_lane(c)];
+            if ((cands & (cands - 1)) == 0) {
+                puzzle->grid[r * 9 + c] = (uint8_t)__builtin_ctz(cands) + 1;
+            }
+        }
+    }
+}
+
+bool kernel_reduce(sudoku_puzzle_t *puzzle) {
+    kernel_board_t board;
+    kernel_load(&board, puzzle);
+    if (!kernel_propagate(&board)) {
+        return false;
+    }
+    kernel_store(&board, puzzle);
+    return true;
+}
+
+const char *kernel_backend() { return KERNEL_BACKEND; }
@@ -9,6 +9,15 @@
 #include "pico/multicore.h"
 #include <stdio.h>
 
+// Core1 tests carve removals ahead of core0's generators.
+static void core1_main() {
+    while (1) {
+        if (!game_idle()) {
+            tight_loop_contents();
+        }
+    }
+}
+
 int main() {
     stdio_init_all();
 
@@ -25,21 +34,31 @@ int main() {
 
     printf("[>] Seeding gamestate...\n");
     printf("    [>] Initializing game:      "); game_init(); printf("ok\n");
+    printf("    [>] Solver context:         %u bytes\n", (unsigned)sizeof(solver_ctx_t));
     printf("[+] Gamestate ok\n\n");
 
+    multicore_launch_core1(core1_main);
+
     //if (eeprom_clear_high_scores()) {
     //    printf("[>] Initializing high scores:   ok\n\n");
     //} else {
     //    printf("[>] Initializing high scores:   error\n\n");
     //}
 
-    multicore_launch_core1(hub75_spin);
     audio_stop();
     oled_splash();
 
+    hub75_timing_t timing;
+    hub75_get_timing(&timing);
+    printf("[+] Panel: %.0f Hz, %.0f%% lit, %.0f ns LSB\n",
+           timing.refresh_hz, timing.duty * 100.0f, timing.lsb_ns);
+
     printf("[+] Entering game loop\n");
+    // Presenting never waits on the scan, so generation and the pool get
+    // every pass of the loop, not one per panel frame.
     while (1) {
         game_update();
+        hub75_present();
     }
 
     return 0;
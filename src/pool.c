@@ -0,0 +1,94 @@
+#include "pool.h"
+#include "code.h"
+#include "generator.h"
+#include <string.h>
+
+typedef struct {
+    sudoku_puzzle_t puzzles[PUZZLE_POOL_DEPTH];
+    uint32_t codes[PUZZLE_POOL_DEPTH];
+    solve_path_t paths[PUZZLE_POOL_DEPTH];
+    uint8_t head;
+    uint8_t count;
+    puzzle_pool_stats_t stats;
+} puzzle_ring_t;
+
+static puzzle_ring_t rings[DIFFICULTY_COUNT];
+static solver_ctx_t solver;
+static generator_t generator;
+
+void puzzle_pool_init(generator_probe_t *probe) {
+    memset(rings, 0, sizeof(rings));
+    solver_init(&solver);
+    generator_attach(&generator, probe);
+    generator_cancel(&generator);
+}
+
+bool puzzle_pool_pop(difficulty_t difficulty, sudoku_puzzle_t *puzzle,
+                     uint32_t *code, solve_path_t *path) {
+    if (difficulty >= DIFFICULTY_COUNT) {
+        return false;
+    }
+
+    puzzle_ring_t *ring = &rings[difficulty];
+    if (ring->count == 0) {
+        ring->stats.misses++;
+        return false;
+    }
+
+    memcpy(puzzle, &ring->puzzles[ring->head], sizeof(sudoku_puzzle_t));
+    *code = ring->codes[ring->head];
+    *path = ring->paths[ring->head];
+    ring->head = (ring->head + 1) % PUZZLE_POOL_DEPTH;
+    ring->count--;
+    ring->stats.hits++;
+    return true;
+}
+
+// Advances background generation for the emptiest ring by one slice of at
+// most about `budget` solver nodes, pushing the puzzle once it completes.
+// Meant to be called whenever the game loop is idle; returns false once
+// every ring is full.
+bool puzzle_pool_refill(uint32_t budget) {
+    if (!generator_busy(&generator)) {
+        difficulty_t target = DIFFICULTY_COUNT;
+        for (int d = DIFFICULTY_BEGIN; d < DIFFICULTY_COUNT; d++) {
+            if (rings[d].count < PUZZLE_POOL_DEPTH &&
+                (target == DIFFICULTY_COUNT || rings[d].count < rings[target].count)) {
+                target = d;
+            }
+        }
+        if (target == DIFFICULTY_COUNT) {
+            return false;
+        }
+        generator_start(&generator, &solver, target);
+    }
+
+    if (generator_step(&generator, budget) != GENERATOR_DONE) {
+        return true;
+    }
+
+    puzzle_ring_t *ring = &rings[generator.difficulty];
+    unsigned tail = (ring->head + ring->count) % PUZZLE_POOL_DEPTH;
+    memcpy(&ring->puzzles[tail], &generator.puzzle, sizeof(sudoku_puzzle_t));
+    ring->codes[tail] = puzzle_code_make(generator.seed, generator.difficulty);
+    ring->paths[tail] = generator.path;
+    ring->count++;
+    ring->stats.generated++;
+    generator_cancel(&generator);
+    return true;
+}
+
+unsigned puzzle_pool_available(difficulty_t difficulty) {
+    if (difficulty >= DIFFICULTY_COUNT) {
+        return 0;
+    }
+    return rings[difficulty].count;
+}
+
+void puzzle_pool_get_stats(difficulty_t difficulty, puzzle_pool_stats_t *stats) {
+    if (difficulty >= DIFFICULTY_COUNT) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = rings[difficulty].stats;
+}
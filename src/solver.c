@@ -1,92 +1,448 @@
+#include "kernel.h"
 #include "rng.h"
 #include "sudoku.h"
 #include <string.h>
 
-static int solution_count;
-static int max_solutions;
+void solver_seed(solver_ctx_t *ctx, uint32_t seed) {
+    rng_seed(&ctx->rng, seed);
+}
 
-bool solve_puzzle(sudoku_puzzle_t *puzzle) {
-    int row, col;
+void solver_seed_stream(solver_ctx_t *ctx, uint32_t seed, uint32_t stream) {
+    rng_seed_stream(&ctx->rng, seed, stream);
+}
 
-    if (!find_empty_cell(puzzle, &row, &col)) {
-        return true;
+// Under the classic rules the three boxes on the diagonal share no unit, so
+// each can be shuffled on its own. Variant rules tie them together, which
+// leaves only the first one free.
+void fill_diagonal_boxes(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle) {
+    for (int box = 0; box < 9; box += UNITS_CLASSIC ? 3 : 9) {
+        uint8_t numbers[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        rng_shuffle(&ctx->rng, numbers, 9);
+
+        int idx = 0;
+        for (int r = box; r < box + 3; r++) {
+            for (int c = box; c < box + 3; c++) {
+                set(puzzle, r, c, numbers[idx++]);
+            }
+        }
     }
+}
 
-    uint8_t numbers[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
-    shuffle_array(numbers, 9);
+uint32_t solver_node_count(const solver_ctx_t *ctx) { return ctx->node_count; }
 
-    for (int i = 0; i < 9; ++i) {
-        uint8_t num = numbers[i];
+bool solver_unique_result(const solver_ctx_t *ctx) {
+    return ctx->solution_count == 1;
+}
 
-        if (is_valid_placement(puzzle, row, col, num)) {
-            set(puzzle, row, col, num);
+bool has_unique_solution(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle) {
+    solver_unique_begin(ctx, puzzle);
+    solver_unique_step(ctx, UINT32_MAX);
+    return solver_unique_result(ctx);
+}
 
-            if (solve_puzzle(puzzle)) {
-                return true;
-            }
+#if SUDOKU_ENGINE == SUDOKU_ENGINE_BACKTRACK
+
+#define ALL_CANDIDATES 0x1FFU
+#define NO_CELL 0xFFU
+
+typedef enum {
+    SEARCH_BUSY,
+    SEARCH_FOUND,
+    SEARCH_EXHAUSTED,
+} search_t;
 
-            set(puzzle, row, col, 0);
+static inline uint16_t digit_bit(uint8_t num) { return 1U << (num - 1); }
+
+// Digits that none of the cell's peers hold. Peers outside the cell's units
+// are not covered by the masks, so those are read off the grid.
+static inline uint16_t candidates(const solver_engine_t *e,
+                                  const sudoku_puzzle_t *puzzle, int cell) {
+    const uint8_t *units = cell_units[cell];
+    uint16_t used = 0;
+    for (int i = 0; i < CELL_UNITS; i++) {
+        used |= e->units[units[i]];
+    }
+#if UNITS_EXTRA_PEERS
+    CELLSET_FOR_EACH(peer, cell_extra_peers[cell]) {
+        if (puzzle->grid[peer]) {
+            used |= digit_bit(puzzle->grid[peer]);
         }
     }
+#else
+    (void)puzzle;
+#endif
+    return ~used & ALL_CANDIDATES;
+}
 
-    return false;
+#if SUDOKU_SEARCH_MRV
+static inline void bucket_insert(solver_engine_t *e, int cell,
+                                 uint8_t count) {
+    e->count[cell] = count;
+    e->prev[cell] = NO_CELL;
+    e->next[cell] = e->head[count];
+    if (e->head[count] != NO_CELL) {
+        e->prev[e->head[count]] = (uint8_t)cell;
+    }
+    e->head[count] = (uint8_t)cell;
 }
 
-void fill_diagonal_boxes(sudoku_puzzle_t *puzzle) {
-    for (int box = 0; box < 9; box += 3) {
-        uint8_t numbers[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
-        shuffle_array(numbers, 9);
+static inline void bucket_remove(solver_engine_t *e, int cell) {
+    uint8_t prev = e->prev[cell];
+    uint8_t next = e->next[cell];
+    if (prev != NO_CELL) {
+        e->next[prev] = next;
+    } else {
+        e->head[e->count[cell]] = next;
+    }
+    if (next != NO_CELL) {
+        e->prev[next] = prev;
+    }
+}
 
-        int idx = 0;
-        for (int r = box; r < box + 3; r++) {
-            for (int c = box; c < box + 3; c++) {
-                set(puzzle, r, c, numbers[idx++]);
-            }
-        }
+static inline void adjust_peer(solver_engine_t *e, sudoku_puzzle_t *puzzle,
+                               int peer, uint16_t bit, int delta) {
+    if (puzzle->grid[peer] == 0 && (candidates(e, puzzle, peer) & bit)) {
+        uint8_t count = e->count[peer];
+        bucket_remove(e, peer);
+        bucket_insert(e, peer, (uint8_t)(count + delta));
     }
 }
 
-static bool count_solutions_helper(sudoku_puzzle_t *puzzle) {
-    if (solution_count >= max_solutions) {
-        return false;
+// Moves every empty peer of cell that has num as a candidate by delta
+// buckets. Must run while num is still a candidate for those peers, i.e.
+// before a place() updates the masks or after an unplace() has.
+static inline void adjust_peers(solver_engine_t *e, sudoku_puzzle_t *puzzle,
+                                int cell, uint8_t num, int delta) {
+    uint16_t bit = digit_bit(num);
+    for (int i = 0; i < CELL_PEERS; i++) {
+        adjust_peer(e, puzzle, cell_peers[cell][i], bit, delta);
     }
+#if !UNITS_CLASSIC
+    CELLSET_FOR_EACH(peer, cell_variant_peers[cell]) {
+        adjust_peer(e, puzzle, peer, bit, delta);
+    }
+#endif
+}
+#endif
+
+static inline void place(solver_engine_t *e, sudoku_puzzle_t *puzzle,
+                         int cell, uint8_t num) {
+#if SUDOKU_SEARCH_MRV
+    bucket_remove(e, cell);
+    adjust_peers(e, puzzle, cell, num, -1);
+#endif
+    uint16_t bit = digit_bit(num);
+    for (int i = 0; i < CELL_UNITS; i++) {
+        e->units[cell_units[cell][i]] |= bit;
+    }
+    puzzle->grid[cell] = num;
+}
+
+static inline void unplace(solver_engine_t *e, sudoku_puzzle_t *puzzle,
+                           int cell, uint8_t num) {
+    uint16_t bit = digit_bit(num);
+    for (int i = 0; i < CELL_UNITS; i++) {
+        e->units[cell_units[cell][i]] &= ~bit;
+    }
+    puzzle->grid[cell] = 0;
+#if SUDOKU_SEARCH_MRV
+    adjust_peers(e, puzzle, cell, num, +1);
+    bucket_insert(e, cell,
+                  (uint8_t)__builtin_popcount(candidates(e, puzzle, cell)));
+#endif
+}
+
+// Rebuilds the unit masks from the grid. Returns false if the givens
+// already conflict, in which case there is nothing to search.
+static bool load_occupancy(solver_engine_t *e, sudoku_puzzle_t *puzzle) {
+    memset(e->units, 0, sizeof(e->units));
+    e->trail_len = 0;
 
+    for (int cell = 0; cell < 81; cell++) {
+        uint8_t num = puzzle->grid[cell];
+        if (num == 0) {
+            continue;
+        }
+        uint16_t bit = digit_bit(num);
+        if (!(candidates(e, puzzle, cell) & bit)) {
+            return false;
+        }
+        for (int i = 0; i < CELL_UNITS; i++) {
+            e->units[cell_units[cell][i]] |= bit;
+        }
+    }
+
+#if SUDOKU_SEARCH_MRV
+    memset(e->head, NO_CELL, sizeof(e->head));
+    for (int cell = 0; cell < 81; cell++) {
+        if (puzzle->grid[cell] == 0) {
+            bucket_insert(e, cell, (uint8_t)__builtin_popcount(
+                                       candidates(e, puzzle, cell)));
+        }
+    }
+#endif
+
+    return true;
+}
+
+// Picks the cell to branch on next. Returns false once the grid is full;
+// otherwise the cell is stored in cell and its candidates are returned
+// through cands, which is zero at a dead end.
+static bool select_cell(const solver_engine_t *e, sudoku_puzzle_t *puzzle,
+                        int *cell, uint16_t *cands) {
+#if SUDOKU_SEARCH_MRV
+    for (int count = 0; count <= 9; count++) {
+        uint8_t best = e->head[count];
+        if (best != NO_CELL) {
+            *cell = best;
+            *cands = count ? candidates(e, puzzle, best) : 0;
+            return true;
+        }
+    }
+    return false;
+#else
     int row, col;
     if (!find_empty_cell(puzzle, &row, &col)) {
-        solution_count++; // Found a complete solution
-        return (solution_count < max_solutions);
+        return false;
+    }
+    *cell = row * 9 + col;
+    *cands = candidates(e, puzzle, *cell);
+    return true;
+#endif
+}
+
+// Places num at cell and records it on the trail so undo_to() can take
+// it back along with everything placed after it.
+static inline void assign(solver_engine_t *e, sudoku_puzzle_t *puzzle,
+                          int cell, uint8_t num) {
+    place(e, puzzle, cell, num);
+    e->trail[e->trail_len++] = (uint8_t)cell;
+}
+
+static inline void undo_to(solver_engine_t *e, sudoku_puzzle_t *puzzle,
+                           uint8_t mark) {
+    while (e->trail_len > mark) {
+        int cell = e->trail[--e->trail_len];
+        unplace(e, puzzle, cell, puzzle->grid[cell]);
     }
+}
 
-    for (uint8_t num = 1; num <= 9; num++) {
-        if (is_valid_placement(puzzle, row, col, num)) {
-            set(puzzle, row, col, num);
+#if SUDOKU_PROPAGATE
+// Places naked singles (cells with one candidate) and hidden singles
+// (digits with one possible cell in a unit) until neither applies.
+// Returns false on a contradiction: an empty cell without candidates, or
+// a unit where some missing digit has nowhere left to go.
+static bool propagate(solver_engine_t *e, sudoku_puzzle_t *puzzle) {
+    bool progress = true;
 
-            if (!count_solutions_helper(puzzle)) {
-                set(puzzle, row, col, 0);
+    while (progress) {
+        progress = false;
+
+#if SUDOKU_SEARCH_MRV
+        while (e->head[1] != NO_CELL && e->head[0] == NO_CELL) {
+            int cell = e->head[1];
+            uint16_t cands = candidates(e, puzzle, cell);
+            assign(e, puzzle, cell, (uint8_t)__builtin_ctz(cands) + 1);
+        }
+        if (e->head[0] != NO_CELL) {
+            return false;
+        }
+#else
+        for (int cell = 0; cell < 81; cell++) {
+            if (puzzle->grid[cell] != 0) {
+                continue;
+            }
+            uint16_t cands = candidates(e, puzzle, cell);
+            if (cands == 0) {
                 return false;
             }
+            if ((cands & (cands - 1)) == 0) {
+                assign(e, puzzle, cell, (uint8_t)__builtin_ctz(cands) + 1);
+                progress = true;
+            }
+        }
+#endif
 
-            set(puzzle, row, col, 0);
+        for (int unit = 0; unit < UNIT_COUNT; unit++) {
+            const uint8_t *cells = unit_cells[unit];
+            uint16_t once = 0, twice = 0;
+            for (int k = 0; k < 9; k++) {
+                if (puzzle->grid[cells[k]] == 0) {
+                    uint16_t cands = candidates(e, puzzle, cells[k]);
+                    twice |= once & cands;
+                    once |= cands;
+                }
+            }
+
+            if ((once | e->units[unit]) != ALL_CANDIDATES) {
+                return false;
+            }
+
+            uint16_t singles = once & ~twice;
+            while (singles) {
+                uint16_t bit = singles & -singles;
+                singles &= singles - 1;
+
+                int target = -1;
+                for (int k = 0; k < 9; k++) {
+                    if (puzzle->grid[cells[k]] == 0 &&
+                        (candidates(e, puzzle, cells[k]) & bit)) {
+                        target = cells[k];
+                        break;
+                    }
+                }
+                if (target < 0) {
+                    return false;
+                }
+
+                assign(e, puzzle, target, (uint8_t)__builtin_ctz(bit) + 1);
+                progress = true;
+            }
         }
     }
 
     return true;
 }
+#endif
 
-static int count_solutions(sudoku_puzzle_t *puzzle, int max_to_find) {
-    sudoku_puzzle_t temp;
-    memcpy(temp.solution, puzzle->solution, 81);
-    memcpy(temp.grid, puzzle->grid, 81);
+void solver_init(solver_ctx_t *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    rng_seed_entropy(&ctx->rng);
+}
 
-    solution_count = 0;
-    max_solutions = max_to_find;
+// Takes one digit off the frame's untried set: the lowest, or with shuffle
+// a uniformly random one, so the branches come out in a random order.
+static inline uint8_t next_digit(rng_t *rng, solver_frame_t *f, bool shuffle) {
+    uint16_t bits = f->untried;
+    if (shuffle && (bits & (bits - 1))) {
+        uint32_t skip = rng_below(rng, (uint32_t)__builtin_popcount(bits));
+        while (skip--) {
+            bits &= bits - 1;
+        }
+    }
+    uint16_t bit = bits & -bits;
+    f->untried &= ~bit;
+    return (uint8_t)__builtin_ctz(bit) + 1;
+}
 
-    count_solutions_helper(&temp);
+// Backs out of the innermost frame into its next untried branch, closing
+// frames that have none left. Returns false once the whole tree is done,
+// with the grid back as it was before the search.
+static bool next_branch(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle,
+                        bool shuffle) {
+    solver_engine_t *e = &ctx->engine;
 
-    return solution_count;
+    while (e->stack_len > 0) {
+        solver_frame_t *f = &e->stack[e->stack_len - 1];
+        undo_to(e, puzzle, f->branch);
+        if (f->untried) {
+            assign(e, puzzle, f->cell, next_digit(&ctx->rng, f, shuffle));
+            return true;
+        }
+        undo_to(e, puzzle, f->mark);
+        e->stack_len--;
+    }
+    return false;
 }
 
-bool has_unique_solution(sudoku_puzzle_t *puzzle) {
-    int n_solutions = count_solutions(puzzle, 2);
-    return n_solutions == 1;
+// Depth-first search over at most `budget` nodes, without recursion: each
+// open branch point is a frame on the engine's stack, so the search can
+// stop between any two nodes and carry on from there on the next call.
+// Stops for good after max_solutions solutions, leaving the last one in the
+// grid, or once the tree is exhausted.
+static search_t search(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle,
+                       uint32_t budget, bool shuffle) {
+    solver_engine_t *e = &ctx->engine;
+
+    for (; budget > 0; budget--) {
+        const uint8_t mark = e->trail_len;
+        bool open = false;
+        int cell;
+        uint16_t cands;
+
+        ctx->node_count++;
+#if SUDOKU_PROPAGATE
+        if (propagate(e, puzzle))
+#endif
+        {
+            if (!select_cell(e, puzzle, &cell, &cands)) {
+                if (++ctx->solution_count >= ctx->max_solutions) {
+                    return SEARCH_FOUND;
+                }
+            } else if (cands) {
+                solver_frame_t *f = &e->stack[e->stack_len++];
+                f->cell = (uint8_t)cell;
+                f->mark = mark;
+                f->branch = e->trail_len;
+                f->untried = cands;
+                open = true;
+            }
+        }
+
+        if (!open) {
+            undo_to(e, puzzle, mark);
+        }
+        if (!next_branch(ctx, puzzle, shuffle)) {
+            return SEARCH_EXHAUSTED;
+        }
+    }
+    return SEARCH_BUSY;
+}
+
+bool solve_puzzle(solver_ctx_t *ctx, sudoku_puzzle_t *puzzle) {
+    solver_engine_t *e = &ctx->engine;
+
+    ctx->node_count = 0;
+    ctx->searching = false;
+#if SUDOKU_KERNEL
+    uint8_t givens[81];
+    memcpy(givens, puzzle->grid, 81);
+    if (!kernel_reduce(puzzle)) {
+        return false;
+    }
+#endif
+    if (!load_occupancy(e, puzzle)) {
+        return false;
+    }
+    e->stack_len = 0;
+    ctx->solution_count = 0;
+    ctx->max_solutions = 1;
+    if (search(ctx, puzzle, UINT32_MAX, true) == SEARCH_FOUND) {
+        return true;
+    }
+#if SUDOKU_KERNEL
+    memcpy(puzzle->grid, givens, 81);
+#endif
+    return false;
+}
+
+void solver_unique_begin(solver_ctx_t *ctx, const sudoku_puzzle_t *puzzle) {
+    solver_engine_t *e = &ctx->engine;
+
+    memcpy(&e->work, puzzle, sizeof(e->work));
+    ctx->solution_count = 0;
+    ctx->max_solutions = 2;
+    ctx->node_count = 0;
+    ctx->searching = false;
+
+#if SUDOKU_KERNEL
+    if (!kernel_reduce(&e->work)) {
+        return;
+    }
+#endif
+    if (!load_occupancy(e, &e->work)) {
+        return;
+    }
+    e->stack_len = 0;
+    ctx->searching = true;
 }
+
+bool solver_unique_step(solver_ctx_t *ctx, uint32_t budget) {
+    if (ctx->searching &&
+        search(ctx, &ctx->engine.work, budget, false) != SEARCH_BUSY) {
+        ctx->searching = false;
+    }
+    return !ctx->searching;
+}
+
+#endif // SUDOKU_ENGINE == SUDOKU_ENGINE_BACKTRACK
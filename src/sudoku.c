@@ -1,4 +1,5 @@
 #include "sudoku.h"
+#include <string.h>
 
 static inline int get_index(int row, int col) { return row * 9 + col; }
 
@@ -19,24 +20,19 @@ void clear(sudoku_puzzle_t *puzzle) {
 
 bool is_valid_placement(sudoku_puzzle_t *puzzle, int row, int col,
                         uint8_t num) {
-    for (int c = 0; c < 9; c++)
-        if (c != col && get(puzzle, row, c) == num) {
+    int cell = get_index(row, col);
+    for (int i = 0; i < CELL_PEERS; i++) {
+        if (puzzle->grid[cell_peers[cell][i]] == num) {
             return false;
         }
-
-    for (int r = 0; r < 9; r++)
-        if (r != row && get(puzzle, r, col) == num) {
+    }
+#if !UNITS_CLASSIC
+    CELLSET_FOR_EACH(peer, cell_variant_peers[cell]) {
+        if (puzzle->grid[peer] == num) {
             return false;
         }
-
-    int box_row = (int)(row / 3) * 3;
-    int box_col = (int)(col / 3) * 3;
-    for (int r = box_row; r < box_row + 3; r++)
-        for (int c = box_col; c < box_col + 3; c++)
-            if ((c != col || r != row) && get(puzzle, r, c) == num) {
-                return false;
-            }
-
+    }
+#endif
     return true;
 }
 
@@ -49,6 +45,90 @@ bool is_valid(sudoku_puzzle_t *puzzle) {
     return true;
 }
 
+// Adds delta (+1 or -1) occurrences of num at cell.
+static void conflict_index_update(conflict_index_t *index,
+                                  const sudoku_puzzle_t *puzzle, int cell,
+                                  uint8_t num, int delta) {
+    index->filled += delta;
+    for (int i = 0; i < CELL_UNITS; i++) {
+        int unit = cell_units[cell][i];
+        // Padding slots repeat the row unit.
+        if (i > 0 && unit == cell_units[cell][0]) {
+            continue;
+        }
+        uint8_t *count = &index->count[unit][num - 1];
+        if (delta > 0 ? *count >= 1 : *count >= 2) {
+            index->excess += delta;
+        }
+        *count += delta;
+    }
+#if UNITS_EXTRA_PEERS
+    CELLSET_FOR_EACH(peer, cell_extra_peers[cell]) {
+        if (puzzle->grid[peer] == num) {
+            index->extra_clashes += delta;
+        }
+    }
+#else
+    (void)puzzle;
+#endif
+}
+
+void conflict_index_init(conflict_index_t *index, const sudoku_puzzle_t *puzzle) {
+    memset(index, 0, sizeof(*index));
+    sudoku_puzzle_t partial;
+    memset(partial.grid, 0, sizeof(partial.grid));
+
+    // Extra-peer pairs are counted from the later cell only, against the
+    // cells before it.
+    for (int cell = 0; cell < 81; cell++) {
+        uint8_t num = puzzle->grid[cell];
+        if (num != 0) {
+            conflict_index_update(index, &partial, cell, num, +1);
+            partial.grid[cell] = num;
+        }
+    }
+}
+
+void conflict_index_set(conflict_index_t *index, sudoku_puzzle_t *puzzle,
+                        int row, int col, uint8_t value) {
+    int cell = get_index(row, col);
+    uint8_t old = puzzle->grid[cell];
+    if (old == value) {
+        return;
+    }
+
+    // The cell itself is not an extra peer of itself, so its own digit
+    // never counts against it.
+    if (old != 0) {
+        conflict_index_update(index, puzzle, cell, old, -1);
+    }
+    set(puzzle, row, col, value);
+    if (value != 0) {
+        conflict_index_update(index, puzzle, cell, value, +1);
+    }
+}
+
+bool conflict_index_cell(const conflict_index_t *index,
+                         const sudoku_puzzle_t *puzzle, int cell) {
+    uint8_t num = puzzle->grid[cell];
+    if (num == 0) {
+        return false;
+    }
+    for (int i = 0; i < CELL_UNITS; i++) {
+        if (index->count[cell_units[cell][i]][num - 1] > 1) {
+            return true;
+        }
+    }
+#if UNITS_EXTRA_PEERS
+    CELLSET_FOR_EACH(peer, cell_extra_peers[cell]) {
+        if (puzzle->grid[peer] == num) {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
 bool find_empty_cell(sudoku_puzzle_t *puzzle, int *row, int *col) {
     for (int r = 0; r < 9; r++)
         for (int c = 0; c < 9; c++)
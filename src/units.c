@@ -0,0 +1,792 @@
+// Generated by tools/units_gen.c with `make units`; edit the rules there.
+
+#include "units.h"
+
+const uint8_t unit_cells[UNIT_COUNT][9] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8},
+    {9, 10, 11, 12, 13, 14, 15, 16, 17},
+    {18, 19, 20, 21, 22, 23, 24, 25, 26},
+    {27, 28, 29, 30, 31, 32, 33, 34, 35},
+    {36, 37, 38, 39, 40, 41, 42, 43, 44},
+    {45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {54, 55, 56, 57, 58, 59, 60, 61, 62},
+    {63, 64, 65, 66, 67, 68, 69, 70, 71},
+    {72, 73, 74, 75, 76, 77, 78, 79, 80},
+    {0, 9, 18, 27, 36, 45, 54, 63, 72},
+    {1, 10, 19, 28, 37, 46, 55, 64, 73},
+    {2, 11, 20, 29, 38, 47, 56, 65, 74},
+    {3, 12, 21, 30, 39, 48, 57, 66, 75},
+    {4, 13, 22, 31, 40, 49, 58, 67, 76},
+    {5, 14, 23, 32, 41, 50, 59, 68, 77},
+    {6, 15, 24, 33, 42, 51, 60, 69, 78},
+    {7, 16, 25, 34, 43, 52, 61, 70, 79},
+    {8, 17, 26, 35, 44, 53, 62, 71, 80},
+    {0, 1, 2, 9, 10, 11, 18, 19, 20},
+    {3, 4, 5, 12, 13, 14, 21, 22, 23},
+    {6, 7, 8, 15, 16, 17, 24, 25, 26},
+    {27, 28, 29, 36, 37, 38, 45, 46, 47},
+    {30, 31, 32, 39, 40, 41, 48, 49, 50},
+    {33, 34, 35, 42, 43, 44, 51, 52, 53},
+    {54, 55, 56, 63, 64, 65, 72, 73, 74},
+    {57, 58, 59, 66, 67, 68, 75, 76, 77},
+    {60, 61, 62, 69, 70, 71, 78, 79, 80},
+#if SUDOKU_VARIANT_X
+    {0, 10, 20, 30, 40, 50, 60, 70, 80},
+    {8, 16, 24, 32, 40, 48, 56, 64, 72},
+#endif
+#if SUDOKU_VARIANT_WINDOKU
+    {10, 11, 12, 19, 20, 21, 28, 29, 30},
+    {14, 15, 16, 23, 24, 25, 32, 33, 34},
+    {46, 47, 48, 55, 56, 57, 64, 65, 66},
+    {50, 51, 52, 59, 60, 61, 68, 69, 70},
+#endif
+};
+
+const uint8_t cell_units[81][CELL_UNITS] = {
+#if SUDOKU_VARIANT_X && SUDOKU_VARIANT_WINDOKU
+    {0, 9, 18, 27, 0, 0}, {0, 10, 18, 0, 0, 0}, {0, 11, 18, 0, 0, 0},
+    {0, 12, 19, 0, 0, 0}, {0, 13, 19, 0, 0, 0}, {0, 14, 19, 0, 0, 0},
+    {0, 15, 20, 0, 0, 0}, {0, 16, 20, 0, 0, 0}, {0, 17, 20, 0, 28, 0},
+    {1, 9, 18, 1, 1, 1}, {1, 10, 18, 27, 1, 29}, {1, 11, 18, 1, 1, 29},
+    {1, 12, 19, 1, 1, 29}, {1, 13, 19, 1, 1, 1}, {1, 14, 19, 1, 1, 30},
+    {1, 15, 20, 1, 1, 30}, {1, 16, 20, 1, 28, 30}, {1, 17, 20, 1, 1, 1},
+    {2, 9, 18, 2, 2, 2}, {2, 10, 18, 2, 2, 29}, {2, 11, 18, 27, 2, 29},
+    {2, 12, 19, 2, 2, 29}, {2, 13, 19, 2, 2, 2}, {2, 14, 19, 2, 2, 30},
+    {2, 15, 20, 2, 28, 30}, {2, 16, 20, 2, 2, 30}, {2, 17, 20, 2, 2, 2},
+    {3, 9, 21, 3, 3, 3}, {3, 10, 21, 3, 3, 29}, {3, 11, 21, 3, 3, 29},
+    {3, 12, 22, 27, 3, 29}, {3, 13, 22, 3, 3, 3}, {3, 14, 22, 3, 28, 30},
+    {3, 15, 23, 3, 3, 30}, {3, 16, 23, 3, 3, 30}, {3, 17, 23, 3, 3, 3},
+    {4, 9, 21, 4, 4, 4}, {4, 10, 21, 4, 4, 4}, {4, 11, 21, 4, 4, 4},
+    {4, 12, 22, 4, 4, 4}, {4, 13, 22, 27, 28, 4}, {4, 14, 22, 4, 4, 4},
+    {4, 15, 23, 4, 4, 4}, {4, 16, 23, 4, 4, 4}, {4, 17, 23, 4, 4, 4},
+    {5, 9, 21, 5, 5, 5}, {5, 10, 21, 5, 5, 31}, {5, 11, 21, 5, 5, 31},
+    {5, 12, 22, 5, 28, 31}, {5, 13, 22, 5, 5, 5}, {5, 14, 22, 27, 5, 32},
+    {5, 15, 23, 5, 5, 32}, {5, 16, 23, 5, 5, 32}, {5, 17, 23, 5, 5, 5},
+    {6, 9, 24, 6, 6, 6}, {6, 10, 24, 6, 6, 31}, {6, 11, 24, 6, 28, 31},
+    {6, 12, 25, 6, 6, 31}, {6, 13, 25, 6, 6, 6}, {6, 14, 25, 6, 6, 32},
+    {6, 15, 26, 27, 6, 32}, {6, 16, 26, 6, 6, 32}, {6, 17, 26, 6, 6, 6},
+    {7, 9, 24, 7, 7, 7}, {7, 10, 24, 7, 28, 31}, {7, 11, 24, 7, 7, 31},
+    {7, 12, 25, 7, 7, 31}, {7, 13, 25, 7, 7, 7}, {7, 14, 25, 7, 7, 32},
+    {7, 15, 26, 7, 7, 32}, {7, 16, 26, 27, 7, 32}, {7, 17, 26, 7, 7, 7},
+    {8, 9, 24, 8, 28, 8}, {8, 10, 24, 8, 8, 8}, {8, 11, 24, 8, 8, 8},
+    {8, 12, 25, 8, 8, 8}, {8, 13, 25, 8, 8, 8}, {8, 14, 25, 8, 8, 8},
+    {8, 15, 26, 8, 8, 8}, {8, 16, 26, 8, 8, 8}, {8, 17, 26, 27, 8, 8},
+#elif !SUDOKU_VARIANT_X && SUDOKU_VARIANT_WINDOKU
+    {0, 9, 18, 0}, {0, 10, 18, 0}, {0, 11, 18, 0}, {0, 12, 19, 0},
+    {0, 13, 19, 0}, {0, 14, 19, 0}, {0, 15, 20, 0}, {0, 16, 20, 0},
+    {0, 17, 20, 0},
+    {1, 9, 18, 1}, {1, 10, 18, 27}, {1, 11, 18, 27}, {1, 12, 19, 27},
+    {1, 13, 19, 1}, {1, 14, 19, 28}, {1, 15, 20, 28}, {1, 16, 20, 28},
+    {1, 17, 20, 1},
+    {2, 9, 18, 2}, {2, 10, 18, 27}, {2, 11, 18, 27}, {2, 12, 19, 27},
+    {2, 13, 19, 2}, {2, 14, 19, 28}, {2, 15, 20, 28}, {2, 16, 20, 28},
+    {2, 17, 20, 2},
+    {3, 9, 21, 3}, {3, 10, 21, 27}, {3, 11, 21, 27}, {3, 12, 22, 27},
+    {3, 13, 22, 3}, {3, 14, 22, 28}, {3, 15, 23, 28}, {3, 16, 23, 28},
+    {3, 17, 23, 3},
+    {4, 9, 21, 4}, {4, 10, 21, 4}, {4, 11, 21, 4}, {4, 12, 22, 4},
+    {4, 13, 22, 4}, {4, 14, 22, 4}, {4, 15, 23, 4}, {4, 16, 23, 4},
+    {4, 17, 23, 4},
+    {5, 9, 21, 5}, {5, 10, 21, 29}, {5, 11, 21, 29}, {5, 12, 22, 29},
+    {5, 13, 22, 5}, {5, 14, 22, 30}, {5, 15, 23, 30}, {5, 16, 23, 30},
+    {5, 17, 23, 5},
+    {6, 9, 24, 6}, {6, 10, 24, 29}, {6, 11, 24, 29}, {6, 12, 25, 29},
+    {6, 13, 25, 6}, {6, 14, 25, 30}, {6, 15, 26, 30}, {6, 16, 26, 30},
+    {6, 17, 26, 6},
+    {7, 9, 24, 7}, {7, 10, 24, 29}, {7, 11, 24, 29}, {7, 12, 25, 29},
+    {7, 13, 25, 7}, {7, 14, 25, 30}, {7, 15, 26, 30}, {7, 16, 26, 30},
+    {7, 17, 26, 7},
+    {8, 9, 24, 8}, {8, 10, 24, 8}, {8, 11, 24, 8}, {8, 12, 25, 8},
+    {8, 13, 25, 8}, {8, 14, 25, 8}, {8, 15, 26, 8}, {8, 16, 26, 8},
+    {8, 17, 26, 8},
+#elif SUDOKU_VARIANT_X && !SUDOKU_VARIANT_WINDOKU
+    {0, 9, 18, 27, 0}, {0, 10, 18, 0, 0}, {0, 11, 18, 0, 0}, {0, 12, 19, 0, 0},
+    {0, 13, 19, 0, 0}, {0, 14, 19, 0, 0}, {0, 15, 20, 0, 0}, {0, 16, 20, 0, 0},
+    {0, 17, 20, 0, 28},
+    {1, 9, 18, 1, 1}, {1, 10, 18, 27, 1}, {1, 11, 18, 1, 1}, {1, 12, 19, 1, 1},
+    {1, 13, 19, 1, 1}, {1, 14, 19, 1, 1}, {1, 15, 20, 1, 1}, {1, 16, 20, 1, 28},
+    {1, 17, 20, 1, 1},
+    {2, 9, 18, 2, 2}, {2, 10, 18, 2, 2}, {2, 11, 18, 27, 2}, {2, 12, 19, 2, 2},
+    {2, 13, 19, 2, 2}, {2, 14, 19, 2, 2}, {2, 15, 20, 2, 28}, {2, 16, 20, 2, 2},
+    {2, 17, 20, 2, 2},
+    {3, 9, 21, 3, 3}, {3, 10, 21, 3, 3}, {3, 11, 21, 3, 3}, {3, 12, 22, 27, 3},
+    {3, 13, 22, 3, 3}, {3, 14, 22, 3, 28}, {3, 15, 23, 3, 3}, {3, 16, 23, 3, 3},
+    {3, 17, 23, 3, 3},
+    {4, 9, 21, 4, 4}, {4, 10, 21, 4, 4}, {4, 11, 21, 4, 4}, {4, 12, 22, 4, 4},
+    {4, 13, 22, 27, 28}, {4, 14, 22, 4, 4}, {4, 15, 23, 4, 4},
+    {4, 16, 23, 4, 4}, {4, 17, 23, 4, 4},
+    {5, 9, 21, 5, 5}, {5, 10, 21, 5, 5}, {5, 11, 21, 5, 5}, {5, 12, 22, 5, 28},
+    {5, 13, 22, 5, 5}, {5, 14, 22, 27, 5}, {5, 15, 23, 5, 5}, {5, 16, 23, 5, 5},
+    {5, 17, 23, 5, 5},
+    {6, 9, 24, 6, 6}, {6, 10, 24, 6, 6}, {6, 11, 24, 6, 28}, {6, 12, 25, 6, 6},
+    {6, 13, 25, 6, 6}, {6, 14, 25, 6, 6}, {6, 15, 26, 27, 6}, {6, 16, 26, 6, 6},
+    {6, 17, 26, 6, 6},
+    {7, 9, 24, 7, 7}, {7, 10, 24, 7, 28}, {7, 11, 24, 7, 7}, {7, 12, 25, 7, 7},
+    {7, 13, 25, 7, 7}, {7, 14, 25, 7, 7}, {7, 15, 26, 7, 7}, {7, 16, 26, 27, 7},
+    {7, 17, 26, 7, 7},
+    {8, 9, 24, 8, 28}, {8, 10, 24, 8, 8}, {8, 11, 24, 8, 8}, {8, 12, 25, 8, 8},
+    {8, 13, 25, 8, 8}, {8, 14, 25, 8, 8}, {8, 15, 26, 8, 8}, {8, 16, 26, 8, 8},
+    {8, 17, 26, 27, 8},
+#elif !SUDOKU_VARIANT_X && !SUDOKU_VARIANT_WINDOKU
+    {0, 9, 18}, {0, 10, 18}, {0, 11, 18}, {0, 12, 19}, {0, 13, 19}, {0, 14, 19},
+    {0, 15, 20}, {0, 16, 20}, {0, 17, 20},
+    {1, 9, 18}, {1, 10, 18}, {1, 11, 18}, {1, 12, 19}, {1, 13, 19}, {1, 14, 19},
+    {1, 15, 20}, {1, 16, 20}, {1, 17, 20},
+    {2, 9, 18}, {2, 10, 18}, {2, 11, 18}, {2, 12, 19}, {2, 13, 19}, {2, 14, 19},
+    {2, 15, 20}, {2, 16, 20}, {2, 17, 20},
+    {3, 9, 21}, {3, 10, 21}, {3, 11, 21}, {3, 12, 22}, {3, 13, 22}, {3, 14, 22},
+    {3, 15, 23}, {3, 16, 23}, {3, 17, 23},
+    {4, 9, 21}, {4, 10, 21}, {4, 11, 21}, {4, 12, 22}, {4, 13, 22}, {4, 14, 22},
+    {4, 15, 23}, {4, 16, 23}, {4, 17, 23},
+    {5, 9, 21}, {5, 10, 21}, {5, 11, 21}, {5, 12, 22}, {5, 13, 22}, {5, 14, 22},
+    {5, 15, 23}, {5, 16, 23}, {5, 17, 23},
+    {6, 9, 24}, {6, 10, 24}, {6, 11, 24}, {6, 12, 25}, {6, 13, 25}, {6, 14, 25},
+    {6, 15, 26}, {6, 16, 26}, {6, 17, 26},
+    {7, 9, 24}, {7, 10, 24}, {7, 11, 24}, {7, 12, 25}, {7, 13, 25}, {7, 14, 25},
+    {7, 15, 26}, {7, 16, 26}, {7, 17, 26},
+    {8, 9, 24}, {8, 10, 24}, {8, 11, 24}, {8, 12, 25}, {8, 13, 25}, {8, 14, 25},
+    {8, 15, 26}, {8, 16, 26}, {8, 17, 26},
+#endif
+};
+
+const uint8_t cell_box[81] = {
+    0, 0, 0, 1, 1, 1, 2, 2, 2,
+    0, 0, 0, 1, 1, 1, 2, 2, 2,
+    0, 0, 0, 1, 1, 1, 2, 2, 2,
+    3, 3, 3, 4, 4, 4, 5, 5, 5,
+    3, 3, 3, 4, 4, 4, 5, 5, 5,
+    3, 3, 3, 4, 4, 4, 5, 5, 5,
+    6, 6, 6, 7, 7, 7, 8, 8, 8,
+    6, 6, 6, 7, 7, 7, 8, 8, 8,
+    6, 6, 6, 7, 7, 7, 8, 8, 8,
+};
+
+const uint8_t cell_peers[81][CELL_PEERS] = {
+    {1, 2, 3, 4, 5, 6, 7, 8, 9, 18, 27, 36, 45, 54, 63, 72, 10, 11, 19, 20},
+    {0, 2, 3, 4, 5, 6, 7, 8, 10, 19, 28, 37, 46, 55, 64, 73, 11, 9, 20, 18},
+    {0, 1, 3, 4, 5, 6, 7, 8, 11, 20, 29, 38, 47, 56, 65, 74, 9, 10, 18, 19},
+    {0, 1, 2, 4, 5, 6, 7, 8, 12, 21, 30, 39, 48, 57, 66, 75, 13, 14, 22, 23},
+    {0, 1, 2, 3, 5, 6, 7, 8, 13, 22, 31, 40, 49, 58, 67, 76, 14, 12, 23, 21},
+    {0, 1, 2, 3, 4, 6, 7, 8, 14, 23, 32, 41, 50, 59, 68, 77, 12, 13, 21, 22},
+    {0, 1, 2, 3, 4, 5, 7, 8, 15, 24, 33, 42, 51, 60, 69, 78, 16, 17, 25, 26},
+    {0, 1, 2, 3, 4, 5, 6, 8, 16, 25, 34, 43, 52, 61, 70, 79, 17, 15, 26, 24},
+    {0, 1, 2, 3, 4, 5, 6, 7, 17, 26, 35, 44, 53, 62, 71, 80, 15, 16, 24, 25},
+    {10, 11, 12, 13, 14, 15, 16, 17, 0, 18, 27, 36, 45, 54, 63, 72, 19, 20, 1,
+     2},
+    {9, 11, 12, 13, 14, 15, 16, 17, 1, 19, 28, 37, 46, 55, 64, 73, 20, 18, 2,
+     0},
+    {9, 10, 12, 13, 14, 15, 16, 17, 2, 20, 29, 38, 47, 56, 65, 74, 18, 19, 0,
+     1},
+    {9, 10, 11, 13, 14, 15, 16, 17, 3, 21, 30, 39, 48, 57, 66, 75, 22, 23, 4,
+     5},
+    {9, 10, 11, 12, 14, 15, 16, 17, 4, 22, 31, 40, 49, 58, 67, 76, 23, 21, 5,
+     3},
+    {9, 10, 11, 12, 13, 15, 16, 17, 5, 23, 32, 41, 50, 59, 68, 77, 21, 22, 3,
+     4},
+    {9, 10, 11, 12, 13, 14, 16, 17, 6, 24, 33, 42, 51, 60, 69, 78, 25, 26, 7,
+     8},
+    {9, 10, 11, 12, 13, 14, 15, 17, 7, 25, 34, 43, 52, 61, 70, 79, 26, 24, 8,
+     6},
+    {9, 10, 11, 12, 13, 14, 15, 16, 8, 26, 35, 44, 53, 62, 71, 80, 24, 25, 6,
+     7},
+    {19, 20, 21, 22, 23, 24, 25, 26, 0, 9, 27, 36, 45, 54, 63, 72, 1, 2, 10,
+     11},
+    {18, 20, 21, 22, 23, 24, 25, 26, 1, 10, 28, 37, 46, 55, 64, 73, 2, 0, 11,
+     9},
+    {18, 19, 21, 22, 23, 24, 25, 26, 2, 11, 29, 38, 47, 56, 65, 74, 0, 1, 9,
+     10},
+    {18, 19, 20, 22, 23, 24, 25, 26, 3, 12, 30, 39, 48, 57, 66, 75, 4, 5, 13,
+     14},
+    {18, 19, 20, 21, 23, 24, 25, 26, 4, 13, 31, 40, 49, 58, 67, 76, 5, 3, 14,
+     12},
+    {18, 19, 20, 21, 22, 24, 25, 26, 5, 14, 32, 41, 50, 59, 68, 77, 3, 4, 12,
+     13},
+    {18, 19, 20, 21, 22, 23, 25, 26, 6, 15, 33, 42, 51, 60, 69, 78, 7, 8, 16,
+     17},
+    {18, 19, 20, 21, 22, 23, 24, 26, 7, 16, 34, 43, 52, 61, 70, 79, 8, 6, 17,
+     15},
+    {18, 19, 20, 21, 22, 23, 24, 25, 8, 17, 35, 44, 53, 62, 71, 80, 6, 7, 15,
+     16},
+    {28, 29, 30, 31, 32, 33, 34, 35, 0, 9, 18, 36, 45, 54, 63, 72, 37, 38, 46,
+     47},
+    {27, 29, 30, 31, 32, 33, 34, 35, 1, 10, 19, 37, 46, 55, 64, 73, 38, 36, 47,
+     45},
+    {27, 28, 30, 31, 32, 33, 34, 35, 2, 11, 20, 38, 47, 56, 65, 74, 36, 37, 45,
+     46},
+    {27, 28, 29, 31, 32, 33, 34, 35, 3, 12, 21, 39, 48, 57, 66, 75, 40, 41, 49,
+     50},
+    {27, 28, 29, 30, 32, 33, 34, 35, 4, 13, 22, 40, 49, 58, 67, 76, 41, 39, 50,
+     48},
+    {27, 28, 29, 30, 31, 33, 34, 35, 5, 14, 23, 41, 50, 59, 68, 77, 39, 40, 48,
+     49},
+    {27, 28, 29, 30, 31, 32, 34, 35, 6, 15, 24, 42, 51, 60, 69, 78, 43, 44, 52,
+     53},
+    {27, 28, 29, 30, 31, 32, 33, 35, 7, 16, 25, 43, 52, 61, 70, 79, 44, 42, 53,
+     51},
+    {27, 28, 29, 30, 31, 32, 33, 34, 8, 17, 26, 44, 53, 62, 71, 80, 42, 43, 51,
+     52},
+    {37, 38, 39, 40, 41, 42, 43, 44, 0, 9, 18, 27, 45, 54, 63, 72, 46, 47, 28,
+     29},
+    {36, 38, 39, 40, 41, 42, 43, 44, 1, 10, 19, 28, 46, 55, 64, 73, 47, 45, 29,
+     27},
+    {36, 37, 39, 40, 41, 42, 43, 44, 2, 11, 20, 29, 47, 56, 65, 74, 45, 46, 27,
+     28},
+    {36, 37, 38, 40, 41, 42, 43, 44, 3, 12, 21, 30, 48, 57, 66, 75, 49, 50, 31,
+     32},
+    {36, 37, 38, 39, 41, 42, 43, 44, 4, 13, 22, 31, 49, 58, 67, 76, 50, 48, 32,
+     30},
+    {36, 37, 38, 39, 40, 42, 43, 44, 5, 14, 23, 32, 50, 59, 68, 77, 48, 49, 30,
+     31},
+    {36, 37, 38, 39, 40, 41, 43, 44, 6, 15, 24, 33, 51, 60, 69, 78, 52, 53, 34,
+     35},
+    {36, 37, 38, 39, 40, 41, 42, 44, 7, 16, 25, 34, 52, 61, 70, 79, 53, 51, 35,
+     33},
+    {36, 37, 38, 39, 40, 41, 42, 43, 8, 17, 26, 35, 53, 62, 71, 80, 51, 52, 33,
+     34},
+    {46, 47, 48, 49, 50, 51, 52, 53, 0, 9, 18, 27, 36, 54, 63, 72, 28, 29, 37,
+     38},
+    {45, 47, 48, 49, 50, 51, 52, 53, 1, 10, 19, 28, 37, 55, 64, 73, 29, 27, 38,
+     36},
+    {45, 46, 48, 49, 50, 51, 52, 53, 2, 11, 20, 29, 38, 56, 65, 74, 27, 28, 36,
+     37},
+    {45, 46, 47, 49, 50, 51, 52, 53, 3, 12, 21, 30, 39, 57, 66, 75, 31, 32, 40,
+     41},
+    {45, 46, 47, 48, 50, 51, 52, 53, 4, 13, 22, 31, 40, 58, 67, 76, 32, 30, 41,
+     39},
+    {45, 46, 47, 48, 49, 51, 52, 53, 5, 14, 23, 32, 41, 59, 68, 77, 30, 31, 39,
+     40},
+    {45, 46, 47, 48, 49, 50, 52, 53, 6, 15, 24, 33, 42, 60, 69, 78, 34, 35, 43,
+     44},
+    {45, 46, 47, 48, 49, 50, 51, 53, 7, 16, 25, 34, 43, 61, 70, 79, 35, 33, 44,
+     42},
+    {45, 46, 47, 48, 49, 50, 51, 52, 8, 17, 26, 35, 44, 62, 71, 80, 33, 34, 42,
+     43},
+    {55, 56, 57, 58, 59, 60, 61, 62, 0, 9, 18, 27, 36, 45, 63, 72, 64, 65, 73,
+     74},
+    {54, 56, 57, 58, 59, 60, 61, 62, 1, 10, 19, 28, 37, 46, 64, 73, 65, 63, 74,
+     72},
+    {54, 55, 57, 58, 59, 60, 61, 62, 2, 11, 20, 29, 38, 47, 65, 74, 63, 64, 72,
+     73},
+    {54, 55, 56, 58, 59, 60, 61, 62, 3, 12, 21, 30, 39, 48, 66, 75, 67, 68, 76,
+     77},
+    {54, 55, 56, 57, 59, 60, 61, 62, 4, 13, 22, 31, 40, 49, 67, 76, 68, 66, 77,
+     75},
+    {54, 55, 56, 57, 58, 60, 61, 62, 5, 14, 23, 32, 41, 50, 68, 77, 66, 67, 75,
+     76},
+    {54, 55, 56, 57, 58, 59, 61, 62, 6, 15, 24, 33, 42, 51, 69, 78, 70, 71, 79,
+     80},
+    {54, 55, 56, 57, 58, 59, 60, 62, 7, 16, 25, 34, 43, 52, 70, 79, 71, 69, 80,
+     78},
+    {54, 55, 56, 57, 58, 59, 60, 61, 8, 17, 26, 35, 44, 53, 71, 80, 69, 70, 78,
+     79},
+    {64, 65, 66, 67, 68, 69, 70, 71, 0, 9, 18, 27, 36, 45, 54, 72, 73, 74, 55,
+     56},
+    {63, 65, 66, 67, 68, 69, 70, 71, 1, 10, 19, 28, 37, 46, 55, 73, 74, 72, 56,
+     54},
+    {63, 64, 66, 67, 68, 69, 70, 71, 2, 11, 20, 29, 38, 47, 56, 74, 72, 73, 54,
+     55},
+    {63, 64, 65, 67, 68, 69, 70, 71, 3, 12, 21, 30, 39, 48, 57, 75, 76, 77, 58,
+     59},
+    {63, 64, 65, 66, 68, 69, 70, 71, 4, 13, 22, 31, 40, 49, 58, 76, 77, 75, 59,
+     57},
+    {63, 64, 65, 66, 67, 69, 70, 71, 5, 14, 23, 32, 41, 50, 59, 77, 75, 76, 57,
+     58},
+    {63, 64, 65, 66, 67, 68, 70, 71, 6, 15, 24, 33, 42, 51, 60, 78, 79, 80, 61,
+     62},
+    {63, 64, 65, 66, 67, 68, 69, 71, 7, 16, 25, 34, 43, 52, 61, 79, 80, 78, 62,
+     60},
+    {63, 64, 65, 66, 67, 68, 69, 70, 8, 17, 26, 35, 44, 53, 62, 80, 78, 79, 60,
+     61},
+    {73, 74, 75, 76, 77, 78, 79, 80, 0, 9, 18, 27, 36, 45, 54, 63, 55, 56, 64,
+     65},
+    {72, 74, 75, 76, 77, 78, 79, 80, 1, 10, 19, 28, 37, 46, 55, 64, 56, 54, 65,
+     63},
+    {72, 73, 75, 76, 77, 78, 79, 80, 2, 11, 20, 29, 38, 47, 56, 65, 54, 55, 63,
+     64},
+    {72, 73, 74, 76, 77, 78, 79, 80, 3, 12, 21, 30, 39, 48, 57, 66, 58, 59, 67,
+     68},
+    {72, 73, 74, 75, 77, 78, 79, 80, 4, 13, 22, 31, 40, 49, 58, 67, 59, 57, 68,
+     66},
+    {72, 73, 74, 75, 76, 78, 79, 80, 5, 14, 23, 32, 41, 50, 59, 68, 57, 58, 66,
+     67},
+    {72, 73, 74, 75, 76, 77, 79, 80, 6, 15, 24, 33, 42, 51, 60, 69, 61, 62, 70,
+     71},
+    {72, 73, 74, 75, 76, 77, 78, 80, 7, 16, 25, 34, 43, 52, 61, 70, 62, 60, 71,
+     69},
+    {72, 73, 74, 75, 76, 77, 78, 79, 8, 17, 26, 35, 44, 53, 62, 71, 60, 61, 69,
+     70},
+};
+
+#if !UNITS_CLASSIC
+const cellset_t cell_variant_peers[81] = {
+#if SUDOKU_VARIANT_X && SUDOKU_VARIANT_WINDOKU && SUDOKU_VARIANT_ANTI_KNIGHT
+    {{0x0000000, 0x0802008, 0x4010040}}, {{0x0001000, 0x0000000, 0x0000000}},
+    {{0x0202000, 0x0000000, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0008800, 0x0000000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0802000, 0x0000000, 0x0000000}}, {{0x0004000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0202020, 0x0040404}}, {{0x0000000, 0x0000002, 0x0000000}},
+    {{0x0200008, 0x080200d, 0x4010040}}, {{0x0600010, 0x000000a, 0x0000000}},
+    {{0x0180002, 0x0000016, 0x0000000}}, {{0x1100044, 0x0000028, 0x0000000}},
+    {{0x3000080, 0x00000d0, 0x0000000}}, {{0x0c00010, 0x00000a0, 0x0000000}},
+    {{0x0800020, 0x0202160, 0x0040404}}, {{0x0000000, 0x0000080, 0x0000000}},
+    {{0x0000000, 0x0000404, 0x0000000}}, {{0x0001000, 0x0000a0c, 0x0000000}},
+    {{0x0003008, 0x080341b, 0x4010040}}, {{0x0000c04, 0x0002826, 0x0000000}},
+    {{0x0008800, 0x0005044, 0x0000000}}, {{0x0018040, 0x000a0c8, 0x0000000}},
+    {{0x0006020, 0x02161b0, 0x0040404}}, {{0x0004000, 0x0028060, 0x0000000}},
+    {{0x0000000, 0x0010040, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0301a00, 0x0001000, 0x0000000}}, {{0x06c1400, 0x0202000, 0x0000000}},
+    {{0x0982c01, 0x0100400, 0x4010040}}, {{0x1105000, 0x0008800, 0x0000000}},
+    {{0x321a100, 0x1010000, 0x0040404}}, {{0x6c14000, 0x0802000, 0x0000000}},
+    {{0x182c000, 0x0004000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0080000, 0x0000000, 0x0000002}}, {{0x0140000, 0x0200008, 0x0000005}},
+    {{0x0280000, 0x0400010, 0x000000a}}, {{0x0500000, 0x0080002, 0x0000014}},
+    {{0x1b10501, 0x1100044, 0x405046c}}, {{0x1400000, 0x2000080, 0x0000050}},
+    {{0x2800000, 0x0400010, 0x00000a0}}, {{0x5000000, 0x0800020, 0x0000140}},
+    {{0x2000000, 0x0000000, 0x0000080}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0001000, 0x0001a0c}}, {{0x0000000, 0x0002008, 0x000141b}},
+    {{0x1010100, 0x0000404, 0x0042c26}}, {{0x0000000, 0x0008800, 0x0005044}},
+    {{0x0100401, 0x0010040, 0x401a0c8}}, {{0x0000000, 0x0002020, 0x00141b0}},
+    {{0x0000000, 0x0004000, 0x002c060}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0100400, 0x0000000}}, {{0x0000000, 0x0300a00, 0x0001000}},
+    {{0x1010100, 0x06c3420, 0x0203000}}, {{0x0000000, 0x0982800, 0x0100c00}},
+    {{0x0000000, 0x1105000, 0x0008800}}, {{0x0000000, 0x320a000, 0x1018000}},
+    {{0x0100401, 0x6c16008, 0x0806000}}, {{0x0000000, 0x1828000, 0x0004000}},
+    {{0x0000000, 0x1010000, 0x0000000}}, {{0x0000000, 0x0080000, 0x0000000}},
+    {{0x1010100, 0x0342020, 0x0200008}}, {{0x0000000, 0x0280000, 0x0400018}},
+    {{0x0000000, 0x0580000, 0x0080006}}, {{0x0000000, 0x0a00000, 0x1100044}},
+    {{0x0000000, 0x3400000, 0x20000c0}}, {{0x0000000, 0x2800000, 0x0400030}},
+    {{0x0100401, 0x5802008, 0x0800020}}, {{0x0000000, 0x2000000, 0x0000000}},
+    {{0x1010100, 0x0202020, 0x0000000}}, {{0x0000000, 0x0000000, 0x0001000}},
+    {{0x0000000, 0x0000000, 0x0002008}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0000000, 0x0008800}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0000000, 0x0002020}}, {{0x0000000, 0x0000000, 0x0004000}},
+    {{0x0100401, 0x0802008, 0x0000000}},
+#elif !SUDOKU_VARIANT_X && SUDOKU_VARIANT_WINDOKU && SUDOKU_VARIANT_ANTI_KNIGHT
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0001000, 0x0000000, 0x0000000}},
+    {{0x0202000, 0x0000000, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0008800, 0x0000000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0802000, 0x0000000, 0x0000000}}, {{0x0004000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000002, 0x0000000}},
+    {{0x0200008, 0x000000d, 0x0000000}}, {{0x0600010, 0x000000a, 0x0000000}},
+    {{0x0180002, 0x0000016, 0x0000000}}, {{0x1100044, 0x0000028, 0x0000000}},
+    {{0x3000080, 0x00000d0, 0x0000000}}, {{0x0c00010, 0x00000a0, 0x0000000}},
+    {{0x0800020, 0x0000160, 0x0000000}}, {{0x0000000, 0x0000080, 0x0000000}},
+    {{0x0000000, 0x0000404, 0x0000000}}, {{0x0001000, 0x0000a0c, 0x0000000}},
+    {{0x0003008, 0x000141b, 0x0000000}}, {{0x0000c04, 0x0002826, 0x0000000}},
+    {{0x0008800, 0x0005044, 0x0000000}}, {{0x0018040, 0x000a0c8, 0x0000000}},
+    {{0x0006020, 0x00141b0, 0x0000000}}, {{0x0004000, 0x0028060, 0x0000000}},
+    {{0x0000000, 0x0010040, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0301a00, 0x0001000, 0x0000000}}, {{0x06c1400, 0x0202000, 0x0000000}},
+    {{0x0982c00, 0x0100400, 0x0000000}}, {{0x1105000, 0x0008800, 0x0000000}},
+    {{0x321a000, 0x1010000, 0x0000000}}, {{0x6c14000, 0x0802000, 0x0000000}},
+    {{0x182c000, 0x0004000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0080000, 0x0000000, 0x0000002}}, {{0x0140000, 0x0200008, 0x0000005}},
+    {{0x0280000, 0x0400010, 0x000000a}}, {{0x0500000, 0x0080002, 0x0000014}},
+    {{0x0a00000, 0x1100044, 0x0000028}}, {{0x1400000, 0x2000080, 0x0000050}},
+    {{0x2800000, 0x0400010, 0x00000a0}}, {{0x5000000, 0x0800020, 0x0000140}},
+    {{0x2000000, 0x0000000, 0x0000080}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0001000, 0x0001a0c}}, {{0x0000000, 0x0002008, 0x000141b}},
+    {{0x0000000, 0x0000404, 0x0002c26}}, {{0x0000000, 0x0008800, 0x0005044}},
+    {{0x0000000, 0x0010040, 0x001a0c8}}, {{0x0000000, 0x0002020, 0x00141b0}},
+    {{0x0000000, 0x0004000, 0x002c060}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0100400, 0x0000000}}, {{0x0000000, 0x0300a00, 0x0001000}},
+    {{0x0000000, 0x06c1400, 0x0203000}}, {{0x0000000, 0x0982800, 0x0100c00}},
+    {{0x0000000, 0x1105000, 0x0008800}}, {{0x0000000, 0x320a000, 0x1018000}},
+    {{0x0000000, 0x6c14000, 0x0806000}}, {{0x0000000, 0x1828000, 0x0004000}},
+    {{0x0000000, 0x1010000, 0x0000000}}, {{0x0000000, 0x0080000, 0x0000000}},
+    {{0x0000000, 0x0340000, 0x0200008}}, {{0x0000000, 0x0280000, 0x0400018}},
+    {{0x0000000, 0x0580000, 0x0080006}}, {{0x0000000, 0x0a00000, 0x1100044}},
+    {{0x0000000, 0x3400000, 0x20000c0}}, {{0x0000000, 0x2800000, 0x0400030}},
+    {{0x0000000, 0x5800000, 0x0800020}}, {{0x0000000, 0x2000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0001000}},
+    {{0x0000000, 0x0000000, 0x0002008}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0000000, 0x0008800}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0000000, 0x0002020}}, {{0x0000000, 0x0000000, 0x0004000}},
+    {{0x0000000, 0x0000000, 0x0000000}},
+#elif SUDOKU_VARIANT_X && !SUDOKU_VARIANT_WINDOKU && SUDOKU_VARIANT_ANTI_KNIGHT
+    {{0x0000000, 0x0802008, 0x4010040}}, {{0x0001000, 0x0000000, 0x0000000}},
+    {{0x0202000, 0x0000000, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0008800, 0x0000000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0802000, 0x0000000, 0x0000000}}, {{0x0004000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0202020, 0x0040404}}, {{0x0000000, 0x0000002, 0x0000000}},
+    {{0x0200008, 0x080200d, 0x4010040}}, {{0x0400010, 0x000000a, 0x0000000}},
+    {{0x0080002, 0x0000014, 0x0000000}}, {{0x1100044, 0x0000028, 0x0000000}},
+    {{0x2000080, 0x0000050, 0x0000000}}, {{0x0400010, 0x00000a0, 0x0000000}},
+    {{0x0800020, 0x0202160, 0x0040404}}, {{0x0000000, 0x0000080, 0x0000000}},
+    {{0x0000000, 0x0000404, 0x0000000}}, {{0x0001000, 0x0000a08, 0x0000000}},
+    {{0x0002008, 0x0803419, 0x4010040}}, {{0x0000404, 0x0002822, 0x0000000}},
+    {{0x0008800, 0x0005044, 0x0000000}}, {{0x0010040, 0x000a088, 0x0000000}},
+    {{0x0002020, 0x0216130, 0x0040404}}, {{0x0004000, 0x0028020, 0x0000000}},
+    {{0x0000000, 0x0010040, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0200a00, 0x0001000, 0x0000000}}, {{0x0441400, 0x0202000, 0x0000000}},
+    {{0x0982c01, 0x0100400, 0x4010040}}, {{0x1105000, 0x0008800, 0x0000000}},
+    {{0x321a100, 0x1010000, 0x0040404}}, {{0x4414000, 0x0802000, 0x0000000}},
+    {{0x0828000, 0x0004000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0080000, 0x0000000, 0x0000002}}, {{0x0140000, 0x0200008, 0x0000005}},
+    {{0x0280000, 0x0400010, 0x000000a}}, {{0x0500000, 0x0080002, 0x0000014}},
+    {{0x1b10501, 0x1100044, 0x405046c}}, {{0x1400000, 0x2000080, 0x0000050}},
+    {{0x2800000, 0x0400010, 0x00000a0}}, {{0x5000000, 0x0800020, 0x0000140}},
+    {{0x2000000, 0x0000000, 0x0000080}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0001000, 0x0000a08}}, {{0x0000000, 0x0002008, 0x0001411}},
+    {{0x1010100, 0x0000404, 0x0042c26}}, {{0x0000000, 0x0008800, 0x0005044}},
+    {{0x0100401, 0x0010040, 0x401a0c8}}, {{0x0000000, 0x0002020, 0x0014110}},
+    {{0x0000000, 0x0004000, 0x0028020}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0100400, 0x0000000}}, {{0x0000000, 0x0200a00, 0x0001000}},
+    {{0x1010100, 0x0643420, 0x0202000}}, {{0x0000000, 0x0882800, 0x0100400}},
+    {{0x0000000, 0x1105000, 0x0008800}}, {{0x0000000, 0x220a000, 0x1010000}},
+    {{0x0100401, 0x4c16008, 0x0802000}}, {{0x0000000, 0x0828000, 0x0004000}},
+    {{0x0000000, 0x1010000, 0x0000000}}, {{0x0000000, 0x0080000, 0x0000000}},
+    {{0x1010100, 0x0342020, 0x0200008}}, {{0x0000000, 0x0280000, 0x0400010}},
+    {{0x0000000, 0x0500000, 0x0080002}}, {{0x0000000, 0x0a00000, 0x1100044}},
+    {{0x0000000, 0x1400000, 0x2000080}}, {{0x0000000, 0x2800000, 0x0400010}},
+    {{0x0100401, 0x5802008, 0x0800020}}, {{0x0000000, 0x2000000, 0x0000000}},
+    {{0x1010100, 0x0202020, 0x0000000}}, {{0x0000000, 0x0000000, 0x0001000}},
+    {{0x0000000, 0x0000000, 0x0002008}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0000000, 0x0008800}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0000000, 0x0002020}}, {{0x0000000, 0x0000000, 0x0004000}},
+    {{0x0100401, 0x0802008, 0x0000000}},
+#elif !SUDOKU_VARIANT_X && !SUDOKU_VARIANT_WINDOKU && SUDOKU_VARIANT_ANTI_KNIGHT
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0001000, 0x0000000, 0x0000000}},
+    {{0x0202000, 0x0000000, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0008800, 0x0000000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0802000, 0x0000000, 0x0000000}}, {{0x0004000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000002, 0x0000000}},
+    {{0x0200008, 0x0000005, 0x0000000}}, {{0x0400010, 0x000000a, 0x0000000}},
+    {{0x0080002, 0x0000014, 0x0000000}}, {{0x1100044, 0x0000028, 0x0000000}},
+    {{0x2000080, 0x0000050, 0x0000000}}, {{0x0400010, 0x00000a0, 0x0000000}},
+    {{0x0800020, 0x0000140, 0x0000000}}, {{0x0000000, 0x0000080, 0x0000000}},
+    {{0x0000000, 0x0000404, 0x0000000}}, {{0x0001000, 0x0000a08, 0x0000000}},
+    {{0x0002008, 0x0001411, 0x0000000}}, {{0x0000404, 0x0002822, 0x0000000}},
+    {{0x0008800, 0x0005044, 0x0000000}}, {{0x0010040, 0x000a088, 0x0000000}},
+    {{0x0002020, 0x0014110, 0x0000000}}, {{0x0004000, 0x0028020, 0x0000000}},
+    {{0x0000000, 0x0010040, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0200a00, 0x0001000, 0x0000000}}, {{0x0441400, 0x0202000, 0x0000000}},
+    {{0x0882800, 0x0100400, 0x0000000}}, {{0x1105000, 0x0008800, 0x0000000}},
+    {{0x220a000, 0x1010000, 0x0000000}}, {{0x4414000, 0x0802000, 0x0000000}},
+    {{0x0828000, 0x0004000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0080000, 0x0000000, 0x0000002}}, {{0x0140000, 0x0200008, 0x0000005}},
+    {{0x0280000, 0x0400010, 0x000000a}}, {{0x0500000, 0x0080002, 0x0000014}},
+    {{0x0a00000, 0x1100044, 0x0000028}}, {{0x1400000, 0x2000080, 0x0000050}},
+    {{0x2800000, 0x0400010, 0x00000a0}}, {{0x5000000, 0x0800020, 0x0000140}},
+    {{0x2000000, 0x0000000, 0x0000080}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0001000, 0x0000a08}}, {{0x0000000, 0x0002008, 0x0001411}},
+    {{0x0000000, 0x0000404, 0x0002822}}, {{0x0000000, 0x0008800, 0x0005044}},
+    {{0x0000000, 0x0010040, 0x000a088}}, {{0x0000000, 0x0002020, 0x0014110}},
+    {{0x0000000, 0x0004000, 0x0028020}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0100400, 0x0000000}}, {{0x0000000, 0x0200a00, 0x0001000}},
+    {{0x0000000, 0x0441400, 0x0202000}}, {{0x0000000, 0x0882800, 0x0100400}},
+    {{0x0000000, 0x1105000, 0x0008800}}, {{0x0000000, 0x220a000, 0x1010000}},
+    {{0x0000000, 0x4414000, 0x0802000}}, {{0x0000000, 0x0828000, 0x0004000}},
+    {{0x0000000, 0x1010000, 0x0000000}}, {{0x0000000, 0x0080000, 0x0000000}},
+    {{0x0000000, 0x0140000, 0x0200008}}, {{0x0000000, 0x0280000, 0x0400010}},
+    {{0x0000000, 0x0500000, 0x0080002}}, {{0x0000000, 0x0a00000, 0x1100044}},
+    {{0x0000000, 0x1400000, 0x2000080}}, {{0x0000000, 0x2800000, 0x0400010}},
+    {{0x0000000, 0x5000000, 0x0800020}}, {{0x0000000, 0x2000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0001000}},
+    {{0x0000000, 0x0000000, 0x0002008}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0000000, 0x0008800}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0000000, 0x0002020}}, {{0x0000000, 0x0000000, 0x0004000}},
+    {{0x0000000, 0x0000000, 0x0000000}},
+#elif SUDOKU_VARIANT_X && SUDOKU_VARIANT_WINDOKU && !SUDOKU_VARIANT_ANTI_KNIGHT
+    {{0x0000000, 0x0802008, 0x4010040}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0202020, 0x0040404}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0200000, 0x080200c, 0x4010040}}, {{0x0200000, 0x000000a, 0x0000000}},
+    {{0x0180000, 0x0000006, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x3000000, 0x00000c0, 0x0000000}}, {{0x0800000, 0x00000a0, 0x0000000}},
+    {{0x0800000, 0x0202060, 0x0040404}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0001000, 0x000000c, 0x0000000}},
+    {{0x0001000, 0x080200a, 0x4010040}}, {{0x0000c00, 0x0000006, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0018000, 0x00000c0, 0x0000000}},
+    {{0x0004000, 0x02020a0, 0x0040404}}, {{0x0004000, 0x0000060, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0301800, 0x0000000, 0x0000000}}, {{0x0281400, 0x0000000, 0x0000000}},
+    {{0x0180c01, 0x0000000, 0x4010040}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x3018100, 0x0000000, 0x0040404}}, {{0x2814000, 0x0000000, 0x0000000}},
+    {{0x180c000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x1110501, 0x0000000, 0x4050444}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x000180c}}, {{0x0000000, 0x0000000, 0x000140a}},
+    {{0x1010100, 0x0000000, 0x0040c06}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0100401, 0x0000000, 0x40180c0}}, {{0x0000000, 0x0000000, 0x00140a0}},
+    {{0x0000000, 0x0000000, 0x000c060}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0300000, 0x0001000}},
+    {{0x1010100, 0x0282020, 0x0001000}}, {{0x0000000, 0x0180000, 0x0000c00}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x3000000, 0x0018000}},
+    {{0x0100401, 0x2802008, 0x0004000}}, {{0x0000000, 0x1800000, 0x0004000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x1010100, 0x0302020, 0x0000008}}, {{0x0000000, 0x0280000, 0x0000008}},
+    {{0x0000000, 0x0180000, 0x0000006}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x3000000, 0x00000c0}}, {{0x0000000, 0x2800000, 0x0000020}},
+    {{0x0100401, 0x1802008, 0x0000020}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x1010100, 0x0202020, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0100401, 0x0802008, 0x0000000}},
+#elif !SUDOKU_VARIANT_X && SUDOKU_VARIANT_WINDOKU && !SUDOKU_VARIANT_ANTI_KNIGHT
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0200000, 0x000000c, 0x0000000}}, {{0x0200000, 0x000000a, 0x0000000}},
+    {{0x0180000, 0x0000006, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x3000000, 0x00000c0, 0x0000000}}, {{0x0800000, 0x00000a0, 0x0000000}},
+    {{0x0800000, 0x0000060, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0001000, 0x000000c, 0x0000000}},
+    {{0x0001000, 0x000000a, 0x0000000}}, {{0x0000c00, 0x0000006, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0018000, 0x00000c0, 0x0000000}},
+    {{0x0004000, 0x00000a0, 0x0000000}}, {{0x0004000, 0x0000060, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0301800, 0x0000000, 0x0000000}}, {{0x0281400, 0x0000000, 0x0000000}},
+    {{0x0180c00, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x3018000, 0x0000000, 0x0000000}}, {{0x2814000, 0x0000000, 0x0000000}},
+    {{0x180c000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x000180c}}, {{0x0000000, 0x0000000, 0x000140a}},
+    {{0x0000000, 0x0000000, 0x0000c06}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x00180c0}}, {{0x0000000, 0x0000000, 0x00140a0}},
+    {{0x0000000, 0x0000000, 0x000c060}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0300000, 0x0001000}},
+    {{0x0000000, 0x0280000, 0x0001000}}, {{0x0000000, 0x0180000, 0x0000c00}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x3000000, 0x0018000}},
+    {{0x0000000, 0x2800000, 0x0004000}}, {{0x0000000, 0x1800000, 0x0004000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0300000, 0x0000008}}, {{0x0000000, 0x0280000, 0x0000008}},
+    {{0x0000000, 0x0180000, 0x0000006}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x3000000, 0x00000c0}}, {{0x0000000, 0x2800000, 0x0000020}},
+    {{0x0000000, 0x1800000, 0x0000020}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}},
+#elif SUDOKU_VARIANT_X && !SUDOKU_VARIANT_WINDOKU && !SUDOKU_VARIANT_ANTI_KNIGHT
+    {{0x0000000, 0x0802008, 0x4010040}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0202020, 0x0040404}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0802008, 0x4010040}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0202020, 0x0040404}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0802008, 0x4010040}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0202020, 0x0040404}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0100401, 0x0000000, 0x4010040}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x1010100, 0x0000000, 0x0040404}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x1110501, 0x0000000, 0x4050444}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x1010100, 0x0000000, 0x0040404}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0100401, 0x0000000, 0x4010040}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x1010100, 0x0202020, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0100401, 0x0802008, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x1010100, 0x0202020, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0100401, 0x0802008, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x1010100, 0x0202020, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0000000}},
+    {{0x0100401, 0x0802008, 0x0000000}},
+#endif
+};
+#endif
+
+#if UNITS_EXTRA_PEERS
+const cellset_t cell_extra_peers[81] = {
+#if SUDOKU_VARIANT_X && SUDOKU_VARIANT_WINDOKU
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0001000, 0x0000000, 0x0000000}},
+    {{0x0202000, 0x0000000, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0008800, 0x0000000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0802000, 0x0000000, 0x0000000}}, {{0x0004000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000002, 0x0000000}},
+    {{0x0000008, 0x0000001, 0x0000000}}, {{0x0400010, 0x0000000, 0x0000000}},
+    {{0x0000002, 0x0000010, 0x0000000}}, {{0x1100044, 0x0000028, 0x0000000}},
+    {{0x0000080, 0x0000010, 0x0000000}}, {{0x0400010, 0x0000000, 0x0000000}},
+    {{0x0000020, 0x0000100, 0x0000000}}, {{0x0000000, 0x0000080, 0x0000000}},
+    {{0x0000000, 0x0000404, 0x0000000}}, {{0x0000000, 0x0000a00, 0x0000000}},
+    {{0x0002008, 0x0001411, 0x0000000}}, {{0x0000004, 0x0002820, 0x0000000}},
+    {{0x0008800, 0x0005044, 0x0000000}}, {{0x0000040, 0x000a008, 0x0000000}},
+    {{0x0002020, 0x0014110, 0x0000000}}, {{0x0000000, 0x0028000, 0x0000000}},
+    {{0x0000000, 0x0010040, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0000200, 0x0001000, 0x0000000}}, {{0x0440000, 0x0202000, 0x0000000}},
+    {{0x0802000, 0x0100400, 0x0000000}}, {{0x1105000, 0x0008800, 0x0000000}},
+    {{0x0202000, 0x1010000, 0x0000000}}, {{0x4400000, 0x0802000, 0x0000000}},
+    {{0x0020000, 0x0004000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0080000, 0x0000000, 0x0000002}}, {{0x0140000, 0x0200008, 0x0000005}},
+    {{0x0280000, 0x0400010, 0x000000a}}, {{0x0500000, 0x0080002, 0x0000014}},
+    {{0x0a00000, 0x1100044, 0x0000028}}, {{0x1400000, 0x2000080, 0x0000050}},
+    {{0x2800000, 0x0400010, 0x00000a0}}, {{0x5000000, 0x0800020, 0x0000140}},
+    {{0x2000000, 0x0000000, 0x0000080}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0001000, 0x0000200}}, {{0x0000000, 0x0002008, 0x0000011}},
+    {{0x0000000, 0x0000404, 0x0002020}}, {{0x0000000, 0x0008800, 0x0005044}},
+    {{0x0000000, 0x0010040, 0x0002008}}, {{0x0000000, 0x0002020, 0x0000110}},
+    {{0x0000000, 0x0004000, 0x0020000}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0100400, 0x0000000}}, {{0x0000000, 0x0000a00, 0x0000000}},
+    {{0x0000000, 0x0441400, 0x0202000}}, {{0x0000000, 0x0802800, 0x0100000}},
+    {{0x0000000, 0x1105000, 0x0008800}}, {{0x0000000, 0x020a000, 0x1000000}},
+    {{0x0000000, 0x4414000, 0x0802000}}, {{0x0000000, 0x0028000, 0x0000000}},
+    {{0x0000000, 0x1010000, 0x0000000}}, {{0x0000000, 0x0080000, 0x0000000}},
+    {{0x0000000, 0x0040000, 0x0200000}}, {{0x0000000, 0x0000000, 0x0400010}},
+    {{0x0000000, 0x0400000, 0x0080000}}, {{0x0000000, 0x0a00000, 0x1100044}},
+    {{0x0000000, 0x0400000, 0x2000000}}, {{0x0000000, 0x0000000, 0x0400010}},
+    {{0x0000000, 0x4000000, 0x0800000}}, {{0x0000000, 0x2000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0001000}},
+    {{0x0000000, 0x0000000, 0x0002008}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0000000, 0x0008800}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0000000, 0x0002020}}, {{0x0000000, 0x0000000, 0x0004000}},
+    {{0x0000000, 0x0000000, 0x0000000}},
+#elif !SUDOKU_VARIANT_X && SUDOKU_VARIANT_WINDOKU
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0001000, 0x0000000, 0x0000000}},
+    {{0x0202000, 0x0000000, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0008800, 0x0000000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0802000, 0x0000000, 0x0000000}}, {{0x0004000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000002, 0x0000000}},
+    {{0x0000008, 0x0000001, 0x0000000}}, {{0x0400010, 0x0000000, 0x0000000}},
+    {{0x0000002, 0x0000010, 0x0000000}}, {{0x1100044, 0x0000028, 0x0000000}},
+    {{0x0000080, 0x0000010, 0x0000000}}, {{0x0400010, 0x0000000, 0x0000000}},
+    {{0x0000020, 0x0000100, 0x0000000}}, {{0x0000000, 0x0000080, 0x0000000}},
+    {{0x0000000, 0x0000404, 0x0000000}}, {{0x0000000, 0x0000a00, 0x0000000}},
+    {{0x0002008, 0x0001411, 0x0000000}}, {{0x0000004, 0x0002820, 0x0000000}},
+    {{0x0008800, 0x0005044, 0x0000000}}, {{0x0000040, 0x000a008, 0x0000000}},
+    {{0x0002020, 0x0014110, 0x0000000}}, {{0x0000000, 0x0028000, 0x0000000}},
+    {{0x0000000, 0x0010040, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0000200, 0x0001000, 0x0000000}}, {{0x0440000, 0x0202000, 0x0000000}},
+    {{0x0802000, 0x0100400, 0x0000000}}, {{0x1105000, 0x0008800, 0x0000000}},
+    {{0x0202000, 0x1010000, 0x0000000}}, {{0x4400000, 0x0802000, 0x0000000}},
+    {{0x0020000, 0x0004000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0080000, 0x0000000, 0x0000002}}, {{0x0140000, 0x0200008, 0x0000005}},
+    {{0x0280000, 0x0400010, 0x000000a}}, {{0x0500000, 0x0080002, 0x0000014}},
+    {{0x0a00000, 0x1100044, 0x0000028}}, {{0x1400000, 0x2000080, 0x0000050}},
+    {{0x2800000, 0x0400010, 0x00000a0}}, {{0x5000000, 0x0800020, 0x0000140}},
+    {{0x2000000, 0x0000000, 0x0000080}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0001000, 0x0000200}}, {{0x0000000, 0x0002008, 0x0000011}},
+    {{0x0000000, 0x0000404, 0x0002020}}, {{0x0000000, 0x0008800, 0x0005044}},
+    {{0x0000000, 0x0010040, 0x0002008}}, {{0x0000000, 0x0002020, 0x0000110}},
+    {{0x0000000, 0x0004000, 0x0020000}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0100400, 0x0000000}}, {{0x0000000, 0x0000a00, 0x0000000}},
+    {{0x0000000, 0x0441400, 0x0202000}}, {{0x0000000, 0x0802800, 0x0100000}},
+    {{0x0000000, 0x1105000, 0x0008800}}, {{0x0000000, 0x020a000, 0x1000000}},
+    {{0x0000000, 0x4414000, 0x0802000}}, {{0x0000000, 0x0028000, 0x0000000}},
+    {{0x0000000, 0x1010000, 0x0000000}}, {{0x0000000, 0x0080000, 0x0000000}},
+    {{0x0000000, 0x0040000, 0x0200000}}, {{0x0000000, 0x0000000, 0x0400010}},
+    {{0x0000000, 0x0400000, 0x0080000}}, {{0x0000000, 0x0a00000, 0x1100044}},
+    {{0x0000000, 0x0400000, 0x2000000}}, {{0x0000000, 0x0000000, 0x0400010}},
+    {{0x0000000, 0x4000000, 0x0800000}}, {{0x0000000, 0x2000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0001000}},
+    {{0x0000000, 0x0000000, 0x0002008}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0000000, 0x0008800}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0000000, 0x0002020}}, {{0x0000000, 0x0000000, 0x0004000}},
+    {{0x0000000, 0x0000000, 0x0000000}},
+#elif SUDOKU_VARIANT_X && !SUDOKU_VARIANT_WINDOKU
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0001000, 0x0000000, 0x0000000}},
+    {{0x0202000, 0x0000000, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0008800, 0x0000000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0802000, 0x0000000, 0x0000000}}, {{0x0004000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000002, 0x0000000}},
+    {{0x0200008, 0x0000005, 0x0000000}}, {{0x0400010, 0x000000a, 0x0000000}},
+    {{0x0080002, 0x0000014, 0x0000000}}, {{0x1100044, 0x0000028, 0x0000000}},
+    {{0x2000080, 0x0000050, 0x0000000}}, {{0x0400010, 0x00000a0, 0x0000000}},
+    {{0x0800020, 0x0000140, 0x0000000}}, {{0x0000000, 0x0000080, 0x0000000}},
+    {{0x0000000, 0x0000404, 0x0000000}}, {{0x0001000, 0x0000a08, 0x0000000}},
+    {{0x0002008, 0x0001411, 0x0000000}}, {{0x0000404, 0x0002822, 0x0000000}},
+    {{0x0008800, 0x0005044, 0x0000000}}, {{0x0010040, 0x000a088, 0x0000000}},
+    {{0x0002020, 0x0014110, 0x0000000}}, {{0x0004000, 0x0028020, 0x0000000}},
+    {{0x0000000, 0x0010040, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0200a00, 0x0001000, 0x0000000}}, {{0x0441400, 0x0202000, 0x0000000}},
+    {{0x0882800, 0x0100400, 0x0000000}}, {{0x1105000, 0x0008800, 0x0000000}},
+    {{0x220a000, 0x1010000, 0x0000000}}, {{0x4414000, 0x0802000, 0x0000000}},
+    {{0x0828000, 0x0004000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0080000, 0x0000000, 0x0000002}}, {{0x0140000, 0x0200008, 0x0000005}},
+    {{0x0280000, 0x0400010, 0x000000a}}, {{0x0500000, 0x0080002, 0x0000014}},
+    {{0x0a00000, 0x1100044, 0x0000028}}, {{0x1400000, 0x2000080, 0x0000050}},
+    {{0x2800000, 0x0400010, 0x00000a0}}, {{0x5000000, 0x0800020, 0x0000140}},
+    {{0x2000000, 0x0000000, 0x0000080}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0001000, 0x0000a08}}, {{0x0000000, 0x0002008, 0x0001411}},
+    {{0x0000000, 0x0000404, 0x0002822}}, {{0x0000000, 0x0008800, 0x0005044}},
+    {{0x0000000, 0x0010040, 0x000a088}}, {{0x0000000, 0x0002020, 0x0014110}},
+    {{0x0000000, 0x0004000, 0x0028020}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0100400, 0x0000000}}, {{0x0000000, 0x0200a00, 0x0001000}},
+    {{0x0000000, 0x0441400, 0x0202000}}, {{0x0000000, 0x0882800, 0x0100400}},
+    {{0x0000000, 0x1105000, 0x0008800}}, {{0x0000000, 0x220a000, 0x1010000}},
+    {{0x0000000, 0x4414000, 0x0802000}}, {{0x0000000, 0x0828000, 0x0004000}},
+    {{0x0000000, 0x1010000, 0x0000000}}, {{0x0000000, 0x0080000, 0x0000000}},
+    {{0x0000000, 0x0140000, 0x0200008}}, {{0x0000000, 0x0280000, 0x0400010}},
+    {{0x0000000, 0x0500000, 0x0080002}}, {{0x0000000, 0x0a00000, 0x1100044}},
+    {{0x0000000, 0x1400000, 0x2000080}}, {{0x0000000, 0x2800000, 0x0400010}},
+    {{0x0000000, 0x5000000, 0x0800020}}, {{0x0000000, 0x2000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0001000}},
+    {{0x0000000, 0x0000000, 0x0002008}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0000000, 0x0008800}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0000000, 0x0002020}}, {{0x0000000, 0x0000000, 0x0004000}},
+    {{0x0000000, 0x0000000, 0x0000000}},
+#elif !SUDOKU_VARIANT_X && !SUDOKU_VARIANT_WINDOKU
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0001000, 0x0000000, 0x0000000}},
+    {{0x0202000, 0x0000000, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0008800, 0x0000000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0802000, 0x0000000, 0x0000000}}, {{0x0004000, 0x0000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000002, 0x0000000}},
+    {{0x0200008, 0x0000005, 0x0000000}}, {{0x0400010, 0x000000a, 0x0000000}},
+    {{0x0080002, 0x0000014, 0x0000000}}, {{0x1100044, 0x0000028, 0x0000000}},
+    {{0x2000080, 0x0000050, 0x0000000}}, {{0x0400010, 0x00000a0, 0x0000000}},
+    {{0x0800020, 0x0000140, 0x0000000}}, {{0x0000000, 0x0000080, 0x0000000}},
+    {{0x0000000, 0x0000404, 0x0000000}}, {{0x0001000, 0x0000a08, 0x0000000}},
+    {{0x0002008, 0x0001411, 0x0000000}}, {{0x0000404, 0x0002822, 0x0000000}},
+    {{0x0008800, 0x0005044, 0x0000000}}, {{0x0010040, 0x000a088, 0x0000000}},
+    {{0x0002020, 0x0014110, 0x0000000}}, {{0x0004000, 0x0028020, 0x0000000}},
+    {{0x0000000, 0x0010040, 0x0000000}}, {{0x0100400, 0x0000000, 0x0000000}},
+    {{0x0200a00, 0x0001000, 0x0000000}}, {{0x0441400, 0x0202000, 0x0000000}},
+    {{0x0882800, 0x0100400, 0x0000000}}, {{0x1105000, 0x0008800, 0x0000000}},
+    {{0x220a000, 0x1010000, 0x0000000}}, {{0x4414000, 0x0802000, 0x0000000}},
+    {{0x0828000, 0x0004000, 0x0000000}}, {{0x1010000, 0x0000000, 0x0000000}},
+    {{0x0080000, 0x0000000, 0x0000002}}, {{0x0140000, 0x0200008, 0x0000005}},
+    {{0x0280000, 0x0400010, 0x000000a}}, {{0x0500000, 0x0080002, 0x0000014}},
+    {{0x0a00000, 0x1100044, 0x0000028}}, {{0x1400000, 0x2000080, 0x0000050}},
+    {{0x2800000, 0x0400010, 0x00000a0}}, {{0x5000000, 0x0800020, 0x0000140}},
+    {{0x2000000, 0x0000000, 0x0000080}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0001000, 0x0000a08}}, {{0x0000000, 0x0002008, 0x0001411}},
+    {{0x0000000, 0x0000404, 0x0002822}}, {{0x0000000, 0x0008800, 0x0005044}},
+    {{0x0000000, 0x0010040, 0x000a088}}, {{0x0000000, 0x0002020, 0x0014110}},
+    {{0x0000000, 0x0004000, 0x0028020}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0100400, 0x0000000}}, {{0x0000000, 0x0200a00, 0x0001000}},
+    {{0x0000000, 0x0441400, 0x0202000}}, {{0x0000000, 0x0882800, 0x0100400}},
+    {{0x0000000, 0x1105000, 0x0008800}}, {{0x0000000, 0x220a000, 0x1010000}},
+    {{0x0000000, 0x4414000, 0x0802000}}, {{0x0000000, 0x0828000, 0x0004000}},
+    {{0x0000000, 0x1010000, 0x0000000}}, {{0x0000000, 0x0080000, 0x0000000}},
+    {{0x0000000, 0x0140000, 0x0200008}}, {{0x0000000, 0x0280000, 0x0400010}},
+    {{0x0000000, 0x0500000, 0x0080002}}, {{0x0000000, 0x0a00000, 0x1100044}},
+    {{0x0000000, 0x1400000, 0x2000080}}, {{0x0000000, 0x2800000, 0x0400010}},
+    {{0x0000000, 0x5000000, 0x0800020}}, {{0x0000000, 0x2000000, 0x0000000}},
+    {{0x0000000, 0x0000000, 0x0000000}}, {{0x0000000, 0x0000000, 0x0001000}},
+    {{0x0000000, 0x0000000, 0x0002008}}, {{0x0000000, 0x0000000, 0x0000404}},
+    {{0x0000000, 0x0000000, 0x0008800}}, {{0x0000000, 0x0000000, 0x0010040}},
+    {{0x0000000, 0x0000000, 0x0002020}}, {{0x0000000, 0x0000000, 0x0004000}},
+    {{0x0000000, 0x0000000, 0x0000000}},
+#endif
+};
+#endif
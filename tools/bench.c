@@ -0,0 +1,360 @@
+// Host-side solver benchmark. Times solve_puzzle(), has_unique_solution(),
+// their batch versions and the full generate-and-carve path over the
+// bundled datasets and prints one JSON object per benchmark on stdout, so
+// runs can be diffed and tracked across solver changes. Generation is timed
+// on one thread, again with a second thread driving a probe as core1 does
+// on the device, and once more with the two interleaved on one thread as a
+// model of two cores for hosts that lack them. Build with `make bench`.
+
+#include "game.h"
+#include "generator.h"
+#include "kernel.h"
+#include "sudoku.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if SUDOKU_ENGINE == SUDOKU_ENGINE_DLX
+#define ENGINE_NAME "dlx"
+#elif SUDOKU_SEARCH_MRV
+#define ENGINE_NAME "backtrack-mrv"
+#else
+#define ENGINE_NAME "backtrack"
+#endif
+
+#if SUDOKU_KERNEL && SUDOKU_ENGINE == SUDOKU_ENGINE_BACKTRACK
+#define KERNEL_NAME kernel_backend()
+#else
+#define KERNEL_NAME "off"
+#endif
+
+typedef struct {
+    double *latency_us;
+    uint64_t nodes;
+    size_t count;
+} samples_t;
+
+typedef struct {
+    const char *name;
+    sudoku_puzzle_t *puzzles;
+    size_t count;
+} dataset_t;
+
+static solver_ctx_t solver;
+static generator_probe_t probe;
+static volatile bool probe_stop;
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static bool load_dataset(dataset_t *set, const char *dir, const char *name) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.txt", dir, name);
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+
+    size_t capacity = 16;
+    set->name = name;
+    set->count = 0;
+    set->puzzles = malloc(capacity * sizeof(sudoku_puzzle_t));
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || strlen(line) < 81) {
+            continue;
+        }
+        if (set->count == capacity) {
+            capacity *= 2;
+            set->puzzles = realloc(set->puzzles, capacity * sizeof(sudoku_puzzle_t));
+        }
+        sudoku_puzzle_t *puzzle = &set->puzzles[set->count++];
+        clear(puzzle);
+        for (int i = 0; i < 81; i++) {
+            char ch = line[i];
+            puzzle->grid[i] = (ch >= '1' && ch <= '9') ? (uint8_t)(ch - '0') : 0;
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+static void report(const char *op, const char *dataset, samples_t *samples,
+                   bool has_nodes) {
+    size_t n = samples->count;
+    double total = 0;
+    for (size_t i = 0; i < n; i++) {
+        total += samples->latency_us[i];
+    }
+    qsort(samples->latency_us, n, sizeof(double), compare_doubles);
+
+    printf("{\"engine\":\"%s\",\"kernel\":\"%s\",\"op\":\"%s\",\"dataset\":\"%s\","
+           "\"puzzles\":%zu,\"mean_us\":%.2f,\"p50_us\":%.2f,\"p99_us\":%.2f,",
+           ENGINE_NAME, KERNEL_NAME, op, dataset, n, total / n,
+           samples->latency_us[n / 2], samples->latency_us[(n * 99) / 100]);
+    if (has_nodes) {
+        printf("\"mean_nodes\":%.1f,", (double)samples->nodes / n);
+    } else {
+        printf("\"mean_nodes\":null,");
+    }
+    printf("\"ctx_bytes\":%zu,\"puzzles_per_sec\":%.1f}\n", sizeof(solver_ctx_t),
+           total > 0 ? n * 1e6 / total : 0.0);
+    fflush(stdout);
+}
+
+static void bench_solve(const dataset_t *set, unsigned repeats) {
+    samples_t samples = {
+        .latency_us = malloc(set->count * repeats * sizeof(double)),
+    };
+
+    for (unsigned r = 0; r < repeats; r++) {
+        for (size_t i = 0; i < set->count; i++) {
+            sudoku_puzzle_t puzzle = set->puzzles[i];
+            double start = now_seconds();
+            solve_puzzle(&solver, &puzzle);
+            samples.latency_us[samples.count++] = (now_seconds() - start) * 1e6;
+            samples.nodes += solver_node_count(&solver);
+        }
+    }
+
+    report("solve", set->name, &samples, true);
+    free(samples.latency_us);
+}
+
+static void bench_unique(const dataset_t *set, unsigned repeats) {
+    samples_t samples = {
+        .latency_us = malloc(set->count * repeats * sizeof(double)),
+    };
+
+    for (unsigned r = 0; r < repeats; r++) {
+        for (size_t i = 0; i < set->count; i++) {
+            sudoku_puzzle_t puzzle = set->puzzles[i];
+            double start = now_seconds();
+            has_unique_solution(&solver, &puzzle);
+            samples.latency_us[samples.count++] = (now_seconds() - start) * 1e6;
+            samples.nodes += solver_node_count(&solver);
+        }
+    }
+
+    report("unique", set->name, &samples, true);
+    free(samples.latency_us);
+}
+
+// The batch calls time the whole dataset at once, so every puzzle in a
+// repeat is charged an equal share of it.
+static void bench_batch(const dataset_t *set, unsigned repeats, bool unique) {
+    samples_t samples = {
+        .latency_us = malloc(set->count * repeats * sizeof(double)),
+    };
+    sudoku_puzzle_t *puzzles = malloc(set->count * sizeof(sudoku_puzzle_t));
+    bool *results = malloc(set->count * sizeof(bool));
+
+    for (unsigned r = 0; r < repeats; r++) {
+        memcpy(puzzles, set->puzzles, set->count * sizeof(sudoku_puzzle_t));
+        double start = now_seconds();
+        size_t hits;
+        if (unique) {
+            hits = has_unique_solution_batch(puzzles, set->count, results);
+        } else {
+            hits = solve_puzzle_batch(puzzles, set->count, results);
+        }
+        if (hits == SOLVER_BATCH_FAILED) {
+            fprintf(stderr, "%s: out of memory\n", set->name);
+            exit(1);
+        }
+        double share = (now_seconds() - start) * 1e6 / set->count;
+        for (size_t i = 0; i < set->count; i++) {
+            samples.latency_us[samples.count++] = share;
+        }
+    }
+
+    report(unique ? "unique-batch" : "solve-batch", set->name, &samples, false);
+    free(results);
+    free(puzzles);
+    free(samples.latency_us);
+}
+
+typedef enum {
+    GENERATE_ALONE,
+    // A second thread runs the probe.
+    GENERATE_THREADED,
+    // Two cores simulated on this thread. Each side keeps a clock of the
+    // time its own calls took, and the one behind goes next; an idle probe
+    // catches up with the generator. Both run in slices of one node, so
+    // they see each other's results about as soon as real cores would.
+    // Hand-over costs are left out.
+    GENERATE_LOCKSTEP,
+} generate_mode_t;
+
+static const char *const GENERATE_OPS[] = {"generate", "generate-2t",
+                                           "generate-lockstep"};
+
+static void *probe_main(void *arg) {
+    (void)arg;
+    while (!probe_stop) {
+        if (!generator_probe_run(&probe, GENERATOR_PROBE_NODES)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+// The puzzles are the same in every mode; mean_nodes only counts the
+// generator's own solver.
+static void bench_generate(difficulty_t difficulty, unsigned count,
+                           generate_mode_t mode) {
+    samples_t samples = {
+        .latency_us = malloc(count * sizeof(double)),
+    };
+    generator_t gen = {.probe = NULL};
+    pthread_t helper;
+    if (mode != GENERATE_ALONE) {
+        generator_probe_init(&probe);
+        generator_attach(&gen, &probe);
+    }
+    if (mode == GENERATE_THREADED) {
+        probe_stop = false;
+        pthread_create(&helper, NULL, probe_main, NULL);
+    }
+
+    for (unsigned i = 0; i < count; i++) {
+        double start = now_seconds();
+        double elapsed = 0;
+        generator_start_seed(&gen, &solver, difficulty, i);
+        if (mode == GENERATE_LOCKSTEP) {
+            double probe_clock = 0;
+            generator_phase_t phase = gen.phase;
+            while (phase != GENERATOR_DONE) {
+                double call = now_seconds();
+                if (elapsed <= probe_clock) {
+                    phase = generator_step(&gen, 1);
+                    elapsed += now_seconds() - call;
+                } else if (generator_probe_run(&probe, 1)) {
+                    probe_clock += now_seconds() - call;
+                } else {
+                    probe_clock = elapsed;
+                }
+            }
+        } else {
+            // With the whole budget, a step only returns early to wait on
+            // the probe.
+            while (generator_step(&gen, UINT32_MAX) != GENERATOR_DONE) {
+                sched_yield();
+            }
+            elapsed = now_seconds() - start;
+        }
+        samples.latency_us[samples.count++] = elapsed * 1e6;
+        samples.nodes += gen.nodes;
+    }
+
+    if (mode == GENERATE_THREADED) {
+        probe_stop = true;
+        pthread_join(helper, NULL);
+    }
+    report(GENERATE_OPS[mode], DIFFICULTY_NAMES[difficulty], &samples, true);
+    free(samples.latency_us);
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-d datadir] [-n count] [-r repeats] [-s seed]\n",
+            argv0);
+}
+
+int main(int argc, char **argv) {
+    const char *data_dir = "tools/data";
+    unsigned count = 1000;
+    unsigned repeats = 20;
+    uint32_t seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:n:r:s:h")) != -1) {
+        switch (opt) {
+        case 'd':
+            data_dir = optarg;
+            break;
+        case 'n':
+            count = (unsigned)strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            repeats = (unsigned)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (count == 0 || repeats == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    solver_init(&solver);
+    solver_seed(&solver, seed);
+
+    // Random fill: solving an empty grid is exactly how the generator
+    // produces its solution boards.
+    dataset_t random_fill = {
+        .name = "random-fill",
+        .puzzles = calloc(count, sizeof(sudoku_puzzle_t)),
+        .count = count,
+    };
+    bench_solve(&random_fill, 1);
+    free(random_fill.puzzles);
+
+    static const char *const files[] = {"17clue", "hardest"};
+    for (size_t f = 0; f < sizeof(files) / sizeof(files[0]); f++) {
+        dataset_t set;
+        if (!load_dataset(&set, data_dir, files[f])) {
+            return 1;
+        }
+        bench_solve(&set, repeats);
+        bench_unique(&set, repeats);
+        bench_batch(&set, repeats, false);
+        bench_batch(&set, repeats, true);
+        free(set.puzzles);
+    }
+
+    // Freshly carved puzzles of every difficulty, the bulk workload the
+    // batch solver is meant for.
+    dataset_t generated = {
+        .name = "generated",
+        .puzzles = malloc(count * sizeof(sudoku_puzzle_t)),
+        .count = count,
+    };
+    // Seeded by index, so every run measures the same puzzles.
+    for (unsigned i = 0; i < count; i++) {
+        generator_create_puzzle(&solver, &generated.puzzles[i],
+                                (difficulty_t)(i % DIFFICULTY_COUNT), i);
+    }
+    bench_solve(&generated, 1);
+    bench_unique(&generated, 1);
+    bench_batch(&generated, 1, false);
+    bench_batch(&generated, 1, true);
+    free(generated.puzzles);
+
+    for (int d = DIFFICULTY_BEGIN; d < DIFFICULTY_COUNT; d++) {
+        bench_generate((difficulty_t)d, count, GENERATE_ALONE);
+        bench_generate((difficulty_t)d, count, GENERATE_THREADED);
+        bench_generate((difficulty_t)d, count, GENERATE_LOCKSTEP);
+    }
+
+    return 0;
+}
@@ -0,0 +1,308 @@
+// Host-side puzzle factory: generates puzzles for every difficulty across
+// all cores and streams them to a file, one puzzle per line:
+//
+//     <difficulty> <grid> <solution> <code>
+//
+// where grid and solution are 81 digits in row-major order and 0 marks an
+// empty cell, and code is the puzzle code (see code.h), and/or packs them
+// into a puzzle bank (see bank.h). With -c it instead regenerates the
+// puzzles behind the given codes. Build with `make factory`.
+
+#include "bank.h"
+#include "code.h"
+#include "game.h"
+#include "generator.h"
+#include "rng.h"
+#include "sudoku.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Jobs are puzzle indices; job / per_difficulty is the difficulty. Each
+// worker owns a deque, pops from its bottom and, once empty, steals from
+// the top of the others.
+typedef struct {
+    pthread_mutex_t lock;
+    unsigned *jobs;
+    unsigned top;
+    unsigned bottom;
+} job_deque_t;
+
+typedef struct {
+    unsigned id;
+    pthread_t thread;
+    job_deque_t deque;
+    solver_ctx_t solver;
+    unsigned generated;
+    unsigned stolen;
+    double seconds;
+} worker_t;
+
+static worker_t *workers;
+static unsigned n_workers;
+static unsigned per_difficulty;
+static uint32_t seed;
+
+static FILE *output;
+static pthread_mutex_t output_lock = PTHREAD_MUTEX_INITIALIZER;
+static bank_writer_t bank;
+static bool write_bank;
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool pop_job(job_deque_t *deque, unsigned *job) {
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom > deque->top) {
+        *job = deque->jobs[--deque->bottom];
+        found = true;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static bool steal_job(job_deque_t *deque, unsigned *job) {
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->bottom > deque->top) {
+        *job = deque->jobs[deque->top++];
+        found = true;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static bool next_job(worker_t *self, unsigned *job) {
+    if (pop_job(&self->deque, job)) {
+        return true;
+    }
+    for (unsigned i = 1; i < n_workers; i++) {
+        worker_t *victim = &workers[(self->id + i) % n_workers];
+        if (steal_job(&victim->deque, job)) {
+            self->stolen++;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void write_puzzle(difficulty_t difficulty, const sudoku_puzzle_t *puzzle,
+                         uint32_t code) {
+    char line[2 * 81 + PUZZLE_CODE_DIGITS + 16];
+    int n = snprintf(line, sizeof(line), "%s ", DIFFICULTY_NAMES[difficulty]);
+    for (int i = 0; i < 81; i++) {
+        line[n++] = (char)('0' + puzzle->grid[i]);
+    }
+    line[n++] = ' ';
+    for (int i = 0; i < 81; i++) {
+        line[n++] = (char)('0' + puzzle->solution[i]);
+    }
+    line[n++] = ' ';
+    puzzle_code_format(code, &line[n]);
+    n += PUZZLE_CODE_DIGITS;
+    line[n++] = '\n';
+
+    if (!output) {
+        return;
+    }
+    pthread_mutex_lock(&output_lock);
+    fwrite(line, 1, (size_t)n, output);
+    pthread_mutex_unlock(&output_lock);
+}
+
+static void *worker_main(void *arg) {
+    worker_t *self = arg;
+    double start = now_seconds();
+    unsigned job;
+
+    while (next_job(self, &job)) {
+        difficulty_t difficulty = (difficulty_t)(job / per_difficulty);
+        sudoku_puzzle_t puzzle;
+        // Seeds follow the job, so a seeded run gives the same puzzles no
+        // matter which worker ends up with which job.
+        uint32_t job_seed = (seed + job) % GENERATOR_SEEDS;
+        generator_create_puzzle(&self->solver, &puzzle, difficulty, job_seed);
+        write_puzzle(difficulty, &puzzle, puzzle_code_make(job_seed, difficulty));
+        if (write_bank) {
+            bank_writer_put(&bank, difficulty, job % per_difficulty, &puzzle);
+        }
+        self->generated++;
+    }
+
+    self->seconds = now_seconds() - start;
+    return NULL;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [-n per_difficulty] [-j threads] [-s seed] [-o file] "
+            "[-b bank]\n"
+            "       %s [-o file] -c code [-c code...]\n",
+            argv0, argv0);
+}
+
+// Regenerates the puzzle behind each code, in order.
+static int replay_codes(uint32_t *codes, unsigned count) {
+    static solver_ctx_t solver;
+    solver_init(&solver);
+
+    for (unsigned i = 0; i < count; i++) {
+        uint32_t code_seed;
+        difficulty_t difficulty;
+        if (!puzzle_code_parse(codes[i], &code_seed, &difficulty)) {
+            fprintf(stderr, "bad or foreign puzzle code %09u\n", (unsigned)codes[i]);
+            return 1;
+        }
+        sudoku_puzzle_t puzzle;
+        generator_create_puzzle(&solver, &puzzle, difficulty, code_seed);
+        write_puzzle(difficulty, &puzzle, codes[i]);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *path = NULL;
+    const char *bank_path = NULL;
+    uint32_t *codes = calloc((size_t)argc, sizeof(uint32_t));
+    unsigned n_codes = 0;
+    int opt;
+    if (!codes) {
+        perror("calloc");
+        return 1;
+    }
+
+    seed = rng_entropy();
+    per_difficulty = 100;
+    while ((opt = getopt(argc, argv, "n:j:s:o:b:c:h")) != -1) {
+        switch (opt) {
+        case 'n':
+            per_difficulty = (unsigned)strtoul(optarg, NULL, 0);
+            break;
+        case 'j':
+            threads = strtol(optarg, NULL, 0);
+            break;
+        case 's':
+            seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            codes[n_codes++] = (uint32_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'o':
+            path = optarg;
+            break;
+        case 'b':
+            bank_path = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (threads < 1 || per_difficulty == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (path) {
+        output = fopen(path, "w");
+        if (!output) {
+            perror(path);
+            return 1;
+        }
+    } else if (!bank_path) {
+        output = stdout;
+    }
+
+    if (n_codes > 0) {
+        int status = replay_codes(codes, n_codes);
+        if (output && output != stdout) {
+            fclose(output);
+        }
+        free(codes);
+        return status;
+    }
+    free(codes);
+
+    if (bank_path) {
+        const uint32_t counts[DIFFICULTY_COUNT] = {
+            [DIFFICULTY_EASY] = per_difficulty,
+            [DIFFICULTY_MEDIUM] = per_difficulty,
+            [DIFFICULTY_HARD] = per_difficulty,
+        };
+        if (!bank_writer_open(&bank, counts)) {
+            perror("bank");
+            return 1;
+        }
+        write_bank = true;
+    }
+
+    n_workers = (unsigned)threads;
+    workers = calloc(n_workers, sizeof(worker_t));
+    const unsigned total = per_difficulty * DIFFICULTY_COUNT;
+    if (!workers) {
+        perror("calloc");
+        return 1;
+    }
+
+    // Deal jobs round-robin so every deque starts with a mix of
+    // difficulties; stealing evens out whatever imbalance remains.
+    for (unsigned w = 0; w < n_workers; w++) {
+        worker_t *worker = &workers[w];
+        worker->id = w;
+        pthread_mutex_init(&worker->deque.lock, NULL);
+        worker->deque.jobs = malloc(sizeof(unsigned) * (total / n_workers + 1));
+        if (!worker->deque.jobs) {
+            perror("malloc");
+            return 1;
+        }
+        for (unsigned job = w; job < total; job += n_workers) {
+            worker->deque.jobs[worker->deque.bottom++] = job;
+        }
+        solver_init(&worker->solver);
+    }
+
+    double start = now_seconds();
+    for (unsigned w = 0; w < n_workers; w++) {
+        pthread_create(&workers[w].thread, NULL, worker_main, &workers[w]);
+    }
+    for (unsigned w = 0; w < n_workers; w++) {
+        pthread_join(workers[w].thread, NULL);
+    }
+    double elapsed = now_seconds() - start;
+
+    if (output && output != stdout) {
+        fclose(output);
+    }
+
+    for (unsigned w = 0; w < n_workers; w++) {
+        worker_t *worker = &workers[w];
+        fprintf(stderr, "thread %2u: %6u puzzles (%u stolen) in %7.3f s, %9.1f puzzles/s\n",
+                w, worker->generated, worker->stolen, worker->seconds,
+                worker->seconds > 0 ? worker->generated / worker->seconds : 0.0);
+        free(worker->deque.jobs);
+        pthread_mutex_destroy(&worker->deque.lock);
+    }
+    fprintf(stderr, "total:     %6u puzzles in %7.3f s, %9.1f puzzles/s\n",
+            total, elapsed, elapsed > 0 ? total / elapsed : 0.0);
+
+    if (write_bank) {
+        if (!bank_writer_save(&bank, bank_path)) {
+            perror(bank_path);
+            return 1;
+        }
+        fprintf(stderr, "bank:      %zu bytes, %d bytes per puzzle\n",
+                bank.size, BANK_RECORD_SIZE);
+        bank_writer_close(&bank);
+    }
+
+    free(workers);
+    return 0;
+}
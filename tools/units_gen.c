@@ -0,0 +1,251 @@
+// Writes src/units.c: the unit and peer tables of units.h spelled out as
+// literals for every combination of rule variants, with #if blocks picking
+// the rows that apply. Run `make units` after changing a rule here.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum { VARIANT_X = 1, VARIANT_WINDOKU = 2, VARIANT_ANTI_KNIGHT = 4 };
+
+static const char *const VARIANT_MACROS[] = {
+    "SUDOKU_VARIANT_X",
+    "SUDOKU_VARIANT_WINDOKU",
+    "SUDOKU_VARIANT_ANTI_KNIGHT",
+};
+
+#define WIDTH 80
+
+// Brace-list items are packed onto lines of at most WIDTH columns. Lines
+// start at `indent`, which becomes `next_indent` after each one.
+static char line[WIDTH + 1];
+static size_t line_len;
+static int indent = 4, next_indent = 4;
+
+static void flush(void) {
+    if (line_len > 0) {
+        printf("%*s%s\n", indent, "", line);
+        line_len = 0;
+        indent = next_indent;
+    }
+}
+
+static void item(const char *text) {
+    size_t len = strlen(text);
+    if (line_len > 0 && indent + line_len + 1 + len > WIDTH) {
+        flush();
+    }
+    if (line_len > 0) {
+        line[line_len++] = ' ';
+    }
+    memcpy(line + line_len, text, len + 1);
+    line_len += len;
+}
+
+// A list too long for one line wraps inside its braces.
+static void uint8_list(const uint8_t *values, int count) {
+    char text[20 * 4 + 4] = "{";
+    for (int i = 0; i < count; i++) {
+        sprintf(text + strlen(text), i + 1 < count ? "%d, " : "%d},",
+                values[i]);
+    }
+    if (4 + strlen(text) <= WIDTH) {
+        item(text);
+        return;
+    }
+    flush();
+    next_indent = 5;
+    for (int i = 0; i < count; i++) {
+        sprintf(text, "%s%d%s", i == 0 ? "{" : "", values[i],
+                i + 1 < count ? "," : "},");
+        item(text);
+    }
+    flush();
+    indent = next_indent = 4;
+}
+
+static int box_of(int r, int c) { return r / 3 * 3 + c / 3; }
+
+// Window 0..3 covering the cell, or -1.
+static int window_axis(int x) { return x % 4 == 0 ? -1 : x / 4; }
+
+static int window_of(int r, int c) {
+    if (window_axis(r) < 0 || window_axis(c) < 0) {
+        return -1;
+    }
+    return window_axis(r) * 2 + window_axis(c);
+}
+
+static bool share_classic_unit(int r, int c, int R, int C) {
+    return r == R || c == C || box_of(r, c) == box_of(R, C);
+}
+
+static bool share_variant_unit(int variants, int r, int c, int R, int C) {
+    if ((variants & VARIANT_X) &&
+        ((r == c && R == C) || (r + c == 8 && R + C == 8))) {
+        return true;
+    }
+    return (variants & VARIANT_WINDOKU) && window_of(r, c) >= 0 &&
+           window_of(r, c) == window_of(R, C);
+}
+
+static bool knight_move(int variants, int r, int c, int R, int C) {
+    return (variants & VARIANT_ANTI_KNIGHT) &&
+           (r - R) * (r - R) * (c - C) * (c - C) == 4;
+}
+
+static bool is_variant_peer(int variants, int r, int c, int R, int C) {
+    return !share_classic_unit(r, c, R, C) &&
+           (share_variant_unit(variants, r, c, R, C) ||
+            knight_move(variants, r, c, R, C));
+}
+
+static bool is_extra_peer(int variants, int r, int c, int R, int C) {
+    return is_variant_peer(variants, r, c, R, C) &&
+           !share_variant_unit(variants, r, c, R, C);
+}
+
+// Opens the #if/#elif for one combination of the variants in `mask`.
+static void condition(bool first, int variants, int mask) {
+    printf(first ? "#if " : "#elif ");
+    bool joined = false;
+    for (int v = 0; v < 3; v++) {
+        if (mask & (1 << v)) {
+            printf("%s%s%s", joined ? " && " : "",
+                   variants & (1 << v) ? "" : "!", VARIANT_MACROS[v]);
+            joined = true;
+        }
+    }
+    printf("\n");
+}
+
+static void cell_units_rows(int variants) {
+    for (int cell = 0; cell < 81; cell++) {
+        int r = cell / 9, c = cell % 9;
+        uint8_t units[6] = {r, 9 + c, 18 + box_of(r, c)};
+        int n = 3;
+        if (variants & VARIANT_X) {
+            units[n++] = r == c ? 27 : r;
+            units[n++] = r + c == 8 ? 28 : r;
+        }
+        if (variants & VARIANT_WINDOKU) {
+            int window = window_of(r, c);
+            int first = variants & VARIANT_X ? 29 : 27;
+            units[n++] = window < 0 ? r : first + window;
+        }
+        uint8_list(units, n);
+        if (c == 8) {
+            flush();
+        }
+    }
+}
+
+static void cellset_rows(int variants,
+                         bool (*test)(int, int, int, int, int)) {
+    for (int cell = 0; cell < 81; cell++) {
+        uint32_t band[3] = {0};
+        for (int other = 0; other < 81; other++) {
+            if (test(variants, cell / 9, cell % 9, other / 9, other % 9)) {
+                band[other / 27] |= 1U << (other % 27);
+            }
+        }
+        char text[48];
+        sprintf(text, "{{0x%07x, 0x%07x, 0x%07x}},", (unsigned)band[0],
+                (unsigned)band[1], (unsigned)band[2]);
+        item(text);
+    }
+    flush();
+}
+
+int main(void) {
+    printf("// Generated by tools/units_gen.c with `make units`; edit the rules "
+           "there.\n\n");
+    printf("#include \"units.h\"\n\n");
+
+    printf("const uint8_t unit_cells[UNIT_COUNT][9] = {\n");
+    for (int u = 0; u < 27; u++) {
+        uint8_t cells[9];
+        for (int k = 0; k < 9; k++) {
+            int r = u < 9 ? u : u < 18 ? k : (u - 18) / 3 * 3 + k / 3;
+            int c = u < 9 ? k : u < 18 ? u - 9 : (u - 18) % 3 * 3 + k % 3;
+            cells[k] = r * 9 + c;
+        }
+        uint8_list(cells, 9);
+        flush();
+    }
+    printf("#if SUDOKU_VARIANT_X\n");
+    for (int d = 0; d < 2; d++) {
+        uint8_t cells[9];
+        for (int k = 0; k < 9; k++) {
+            cells[k] = d == 0 ? k * 10 : k * 8 + 8;
+        }
+        uint8_list(cells, 9);
+        flush();
+    }
+    printf("#endif\n#if SUDOKU_VARIANT_WINDOKU\n");
+    for (int w = 0; w < 4; w++) {
+        uint8_t cells[9];
+        for (int k = 0; k < 9; k++) {
+            cells[k] = (1 + w / 2 * 4 + k / 3) * 9 + 1 + w % 2 * 4 + k % 3;
+        }
+        uint8_list(cells, 9);
+        flush();
+    }
+    printf("#endif\n};\n\n");
+
+    // Cells in fewer than CELL_UNITS units repeat their row unit.
+    printf("const uint8_t cell_units[81][CELL_UNITS] = {\n");
+    for (int variants = 3; variants >= 0; variants--) {
+        condition(variants == 3, variants, VARIANT_X | VARIANT_WINDOKU);
+        cell_units_rows(variants);
+    }
+    printf("#endif\n};\n\n");
+
+    printf("const uint8_t cell_box[81] = {\n");
+    for (int cell = 0; cell < 81; cell++) {
+        char text[8];
+        sprintf(text, "%d,", box_of(cell / 9, cell % 9));
+        item(text);
+        if (cell % 9 == 8) {
+            flush();
+        }
+    }
+    printf("};\n\n");
+
+    // The classic peers in a fixed order: the rest of the row, the rest of
+    // the column, then the four cells of the box on neither.
+    printf("const uint8_t cell_peers[81][CELL_PEERS] = {\n");
+    for (int cell = 0; cell < 81; cell++) {
+        int r = cell / 9, c = cell % 9;
+        uint8_t peers[20];
+        for (int k = 0; k < 8; k++) {
+            peers[k] = r * 9 + k + (k >= c);
+            peers[8 + k] = (k + (k >= r)) * 9 + c;
+        }
+        for (int k = 0; k < 4; k++) {
+            peers[16 + k] = (r / 3 * 3 + (r % 3 + 1 + k / 2) % 3) * 9 +
+                            c / 3 * 3 + (c % 3 + 1 + k % 2) % 3;
+        }
+        uint8_list(peers, 20);
+        flush();
+    }
+    printf("};\n\n");
+
+    printf("#if !UNITS_CLASSIC\n");
+    printf("const cellset_t cell_variant_peers[81] = {\n");
+    for (int variants = 7; variants >= 1; variants--) {
+        condition(variants == 7, variants, 7);
+        cellset_rows(variants, is_variant_peer);
+    }
+    printf("#endif\n};\n#endif\n\n");
+
+    printf("#if UNITS_EXTRA_PEERS\n");
+    printf("const cellset_t cell_extra_peers[81] = {\n");
+    for (int variants = 7; variants >= 4; variants--) {
+        condition(variants == 7, variants, VARIANT_X | VARIANT_WINDOKU);
+        cellset_rows(variants, is_extra_peer);
+    }
+    printf("#endif\n};\n#endif\n");
+    return 0;
+}